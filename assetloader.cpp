@@ -0,0 +1,102 @@
+#include "assetloader.h"
+#include <QApplication>
+#include <QFontDatabase>
+#include <QDebug>
+
+AssetLoader::AssetLoader(QObject *parent)
+    : QObject(parent)
+{
+}
+
+AssetLoader::~AssetLoader()
+{
+    // Don't let the worker outlive us
+    if (pending.valid()) {
+        pending.wait();
+    }
+}
+
+void AssetLoader::start()
+{
+    if (pending.valid() || ready) {
+        return;
+    }
+
+    pending = std::async(std::launch::async, [this]() {
+        Decoded result = decode();
+        // Hand over on the GUI thread; dropped if we're gone by then
+        QMetaObject::invokeMethod(this, [this]() { collect(); }, Qt::QueuedConnection);
+        return result;
+    });
+}
+
+AssetLoader::Decoded AssetLoader::decode()
+{
+    Decoded d;
+
+    static const char *const paths[SpriteCount] = {
+        ":/sprites/wall.png",
+        ":/sprites/coin.png",
+        ":/sprites/player.png",
+        ":/sprites/ghost.png"
+    };
+    for (int i = 0; i < SpriteCount; ++i) {
+        d.images[i].load(paths[i]);
+    }
+
+    // Load the pixel font (QFontDatabase is thread-safe)
+    int fontId = QFontDatabase::addApplicationFont(":/fonts/pixel-font.ttf");
+    if (fontId != -1) {
+        d.fontFamily = QFontDatabase::applicationFontFamilies(fontId).at(0);
+    }
+    return d;
+}
+
+void AssetLoader::collect()
+{
+    if (ready) {
+        return;
+    }
+    if (!pending.valid()) {
+        start();
+    }
+    decoded = pending.get();
+    ready = true;
+
+    if (!decoded.fontFamily.isEmpty()) {
+        QFont font(decoded.fontFamily, 12);
+        QApplication::setFont(font); // Set as default
+        emit fontLoaded(font);
+    } else {
+        qWarning() << "Could not load pixel font!";
+    }
+    emit loaded();
+}
+
+QPixmap AssetLoader::pixmap(Sprite sprite)
+{
+    if (!ready) {
+        collect(); // Game started before the decode finished
+    }
+    if (pixmaps[sprite].isNull()) {
+        pixmaps[sprite] = QPixmap::fromImage(decoded.images[sprite]);
+    }
+    return pixmaps[sprite];
+}
+
+QColor AssetLoader::flatColor(Sprite sprite)
+{
+    if (!ready) {
+        collect();
+    }
+    if (!flatColors[sprite].isValid()) {
+        // Smooth-scaling to a single premultiplied pixel averages the
+        // opaque part of the sprite, ignoring its transparent background
+        QImage one = decoded.images[sprite].convertToFormat(QImage::Format_ARGB32_Premultiplied)
+                         .scaled(1, 1, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        QColor c = one.isNull() ? QColor(Qt::gray) : QColor::fromRgba(qUnpremultiply(one.pixel(0, 0)));
+        c.setAlpha(255);
+        flatColors[sprite] = c;
+    }
+    return flatColors[sprite];
+}
@@ -0,0 +1,52 @@
+#ifndef ASSETLOADER_H
+#define ASSETLOADER_H
+
+#include <QObject>
+#include <QImage>
+#include <QPixmap>
+#include <QFont>
+#include <QColor>
+#include <future>
+
+// Decodes the sprite PNGs and registers the pixel font on a background
+// thread, so the main menu can show while they load. QImage decoding is
+// thread-safe; the GUI-only QPixmap conversion happens on first use.
+class AssetLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Sprite { Wall = 0, Coin, Player, Ghost, SpriteCount };
+
+    explicit AssetLoader(QObject *parent = nullptr);
+    ~AssetLoader();
+
+    void start();
+    bool isReady() const { return ready; }
+
+    // GUI thread only. Blocks if the background decode hasn't finished yet.
+    QPixmap pixmap(Sprite sprite);
+    // Average colour of a sprite, for the flat low-detail renderer
+    QColor flatColor(Sprite sprite);
+
+signals:
+    void fontLoaded(const QFont &font);
+    void loaded();
+
+private:
+    struct Decoded {
+        QImage images[SpriteCount];
+        QString fontFamily;
+    };
+
+    std::future<Decoded> pending;
+    Decoded decoded;
+    QPixmap pixmaps[SpriteCount];
+    QColor flatColors[SpriteCount];
+    bool ready = false;
+
+    void collect();
+    static Decoded decode();
+};
+
+#endif // ASSETLOADER_H
@@ -0,0 +1,60 @@
+#ifndef BOT_H
+#define BOT_H
+
+#include "mazesimulation.h"
+
+// Everything a bot sees on one tick.
+// Filled in place by MazeSimulation::observe(); grid and coinBits point
+// into the simulation and stay valid until its next step.
+struct Observation {
+    static constexpr int Window = 11;   // Local view is Window x Window, player at centre
+    static constexpr int MaxGhosts = 10;
+
+    // Local window: maze chars ('1' wall, '0' path, '2' coin, 'E' exit,
+    // 'P' player start, walkable like '0'), 'G' where a ghost stands,
+    // '1' outside the maze. grid / cellAt() use the same chars minus 'G'.
+    char local[Window * Window];
+
+    QPoint player;
+    Direction playerDir = DirNone;
+    int lives = 0;
+
+    int ghostCount = 0;
+    QPoint ghosts[MaxGhosts];
+
+    // Whole maze, read-only, for planners that need more than the window.
+    // Exactly one of grid / packedGrid is set; read cells through cellAt().
+    int rows = 0;
+    int cols = 0;
+    const char *grid = nullptr;
+    const quint8 *packedGrid = nullptr; // Two cells per byte
+    const quint64 *coinBits = nullptr; // One bit per cell, row-major
+    int coinsLeft = 0;
+
+    char cellAt(int index) const
+    {
+        return grid ? grid[index] : MazeSimulation::unpackCell(packedGrid, index);
+    }
+
+    bool hasCoin(int row, int col) const
+    {
+        int i = row * cols + col;
+        return (coinBits[i / 64] >> (i % 64)) & 1;
+    }
+};
+
+// Programmatic player. act() is called once per tick with a fresh
+// observation and returns the direction to steer towards, exactly like
+// a key press on the human path.
+class Bot
+{
+public:
+    virtual ~Bot() = default;
+    virtual Direction act(const Observation &obs) = 0;
+
+    // Scratch memory kept per maze cell, counted against the session's
+    // memory budget (MazeSimulation::setMemoryBudget)
+    virtual qint64 memoryBytesPerCell() const { return 0; }
+};
+
+#endif // BOT_H
@@ -0,0 +1,35 @@
+#include "botdriver.h"
+#include <QElapsedTimer>
+#include <algorithm> // for std::max
+
+BotDriver::Result BotDriver::run(MazeSimulation &sim, Bot &bot, quint64 ticks)
+{
+    Result result;
+    Observation obs;
+
+    sim.setMemoryBudget(sim.memoryBudget(), bot.memoryBytesPerCell());
+    if (sim.rows() == 0) {
+        sim.newGame();
+    }
+
+    QElapsedTimer clock;
+    clock.start();
+
+    for (quint64 t = 0; t < ticks; ++t) {
+        sim.observe(obs);
+        result.bestTotal = std::max(result.bestTotal, sim.total());
+        result.bestLevel = std::max(result.bestLevel, sim.level());
+
+        sim.step(bot.act(obs));
+
+        if (sim.isGameOver()) {
+            result.games++;
+            sim.newGame();
+        }
+    }
+
+    result.ticks = ticks;
+    result.elapsedNs = std::max<qint64>(1, clock.nsecsElapsed());
+    result.ticksPerSecond = double(ticks) * 1e9 / result.elapsedNs;
+    return result;
+}
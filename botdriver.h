@@ -0,0 +1,27 @@
+#ifndef BOTDRIVER_H
+#define BOTDRIVER_H
+
+#include "mazesimulation.h"
+#include "bot.h"
+
+// Runs a bot against a simulation as fast as possible, no rendering.
+// Finished games restart straight away so the run always covers the
+// requested number of ticks. The bot's buffers are counted against the
+// simulation's memory budget, so levels stop growing before they can run
+// out of memory.
+class BotDriver
+{
+public:
+    struct Result {
+        quint64 ticks = 0;
+        qint64 elapsedNs = 0;
+        double ticksPerSecond = 0;
+        int games = 0;
+        int bestLevel = 0;
+        int bestTotal = 0;
+    };
+
+    static Result run(MazeSimulation &sim, Bot &bot, quint64 ticks);
+};
+
+#endif // BOTDRIVER_H
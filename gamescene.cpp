@@ -1,23 +1,55 @@
 #include "gamescene.h"
 #include <QKeyEvent>
-#include <QFile>
-#include <QTextStream>
 #include <QDebug>
 #include <QBrush>
-#include <random>
-#include <QStack>
+#include <QPen>
 #include <algorithm> // for std::max and std::min
 
-GameScene::GameScene(qreal x, qreal y, qreal width, qreal height, QObject *parent)
-    : QGraphicsScene(x, y, width, height, parent)
+// Rough heap cost of scene objects, for memory accounting
+static const qint64 PixmapItemBytes = 320;   // QGraphicsPixmapItem + private data
+static const qint64 RectItemBytes = 280;     // QGraphicsRectItem + private data
+static const qint64 CoinMapNodeBytes = 48;   // One coinItems node
+static const qint64 IndexBytesPerItem = 64;  // BSP leaf entries and tree share
+// At the largest level the budget allows the maze is a flat tile layer at
+// one pixel per cell, still on screen while the next level is generated
+static const qint64 TileLayerBytesPerCell = 4 + 1; // One RGB32 pixel, coin bitmap copy rounded up
+
+GameScene::GameScene(qreal x, qreal y, qreal width, qreal height, AssetLoader *assets, QObject *parent)
+    : QGraphicsScene(x, y, width, height, parent), assets(assets)
 {
     // Set background
     setBackgroundBrush(QBrush(Qt::black));
     playerSprite = nullptr; // Initialize pointer
+    sim = &localGame;
 
     // Timer
     gameTimer = new QTimer(this);
     connect(gameTimer, &QTimer::timeout, this, &GameScene::moveEntities);
+
+    // Monotonic clock for input timestamps
+    inputClock.start();
+
+    // Mazes never outgrow the view at one pixel per cell
+    localGame.setMaxSize(int(height), int(width));
+
+    // Optional pre-turn window override, e.g. MAGE_TURN_BUFFER_MS=250
+    setTurnBufferWindow(qEnvironmentVariableIntValue("MAGE_TURN_BUFFER_MS"));
+
+    // Memory budget, MAGE_MEMORY_BUDGET_MB overrides the 64 MB default
+    bool ok = false;
+    int budgetMb = qEnvironmentVariableIntValue("MAGE_MEMORY_BUDGET_MB", &ok);
+    setMemoryBudget(qint64(ok ? budgetMb : 64) * 1024 * 1024);
+}
+
+void GameScene::setMemoryBudget(qint64 bytes)
+{
+    memoryBudget = std::max<qint64>(0, bytes);
+    localGame.setMemoryBudget(memoryBudget, TileLayerBytesPerCell);
+}
+
+void GameScene::setTurnBufferWindow(int ms)
+{
+    turnBufferMs = std::max(0, ms);
 }
 
 void GameScene::clearLevelItems()
@@ -30,13 +62,11 @@ void GameScene::clearLevelItems()
     }
 
     // Delete ghosts
-    for (Ghost &g : ghosts) {
-        if (g.sprite) {
-            removeItem(g.sprite);
-            delete g.sprite;
-        }
+    for (QGraphicsItem* ghost : ghostSprites) {
+        removeItem(ghost);
+        delete ghost;
     }
-    ghosts.clear();
+    ghostSprites.clear();
 
     // Delete coins
     for (QGraphicsPixmapItem* coin : coinItems) {
@@ -51,170 +81,194 @@ void GameScene::clearLevelItems()
         delete wall;
     }
     wallItems.clear();
+
+    // Delete baked tile layer
+    if (tileLayer) {
+        removeItem(tileLayer);
+        delete tileLayer;
+        tileLayer = nullptr;
+    }
 }
 
 void GameScene::loadLevel(int levelNumber)
 {
     gameTimer->stop();
-    clearLevelItems();
-
-    ghostStartPositions.clear();
-    maze.clear();
-    ROWS = 0;
-    COLS = 0;
-    offsetX = 0;
-    offsetY = 0;
-
-    currentLevel = levelNumber;
-    emit levelChanged(currentLevel);
+    reportInputLatency();
 
-    // Ghost speed scaling
-    ghostMoveFrequency = std::max(1, 3 - (levelNumber - 1));
-    gameTickCounter = 0;
+    sim = &localGame;
+    localGame.loadLevel(levelNumber);
 
-    // Maze size formula
-    int mazeRows = 17 + (levelNumber - 1) * 6;
-    int mazeCols = 25 + (levelNumber - 1) * 8;
-
-    // Fit gridStep to the view
-    int stepX = sceneRect().width() / mazeCols;
-    int stepY = sceneRect().height() / mazeRows;
-    gridStep = std::min(stepX, stepY);
-    blockSize = gridStep;
-
-    generateMaze(mazeRows, mazeCols);
-
-    // Recalculate offsets to center the maze
-    if (ROWS > 0 && COLS > 0) {
-        offsetX = (sceneRect().width() - (COLS * gridStep)) / 2;
-        offsetY = (sceneRect().height() - (ROWS * gridStep)) / 2;
-    }
-
-    drawMaze(); // This will create player/ghost sprites
+    buildLevel();
     initGame();
     gameTimer->start(tickMs);
 }
 
+void GameScene::watchSession(MazeSimulation *session)
+{
+    gameTimer->stop();
+    reportInputLatency();
+
+    sim = session ? session : &localGame;
+    buildLevel();
+    initGame();
+}
 
-void GameScene::generateMaze(int rows, int cols)
+void GameScene::buildLevel()
 {
-    ROWS = rows;
-    COLS = cols;
-    maze.resize(ROWS);
-    for(int r = 0; r < ROWS; ++r) {
-        maze[r].resize(COLS, '1'); // 1 = Wall
+    clearLevelItems();
+    if (sim->rows() == 0 || sim->cols() == 0) {
+        return; // Nothing generated yet
     }
 
-    QVector<QVector<bool>> visited(ROWS, QVector<bool>(COLS, false));
-    QStack<QPoint> stack;
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    // Fit gridStep to the view. Levels are capped to the view's size in
+    // pixels (MazeSimulation::setMaxSize), so a step of 1 still fits; the
+    // clamp only keeps an uncapped session from dividing down to zero.
+    int stepX = sceneRect().width() / sim->cols();
+    int stepY = sceneRect().height() / sim->rows();
+    gridStep = std::max(1, std::min(stepX, stepY));
+    blockSize = gridStep;
 
-    // 1. Start DFS from (1, 1)
-    playerStartPos = QPoint(1, 1);
-    stack.push(playerStartPos);
-    maze[1][1] = '0'; // 0 = Path
-    visited[1][1] = true;
+    // Recalculate offsets to center the maze
+    offsetX = (sceneRect().width() - (sim->cols() * gridStep)) / 2;
+    offsetY = (sceneRect().height() - (sim->rows() * gridStep)) / 2;
 
-    QPoint dirs[4] = {{0, -2}, {0, 2}, {-2, 0}, {2, 0}};
+    chooseRepresentation();
+    drawMaze(); // This will create player/ghost sprites
 
-    while (!stack.isEmpty()) {
-        QPoint current = stack.top();
-        QVector<QPoint> neighbors;
+    builtSerial = sim->levelSerial();
+    shownScore = shownTotal = shownLives = -1;
+    emit levelChanged(sim->level());
+    syncFromSimulation();
+    updateMemoryOverlay();
+}
 
-        std::shuffle(dirs, dirs + 4, gen);
-        for (const QPoint& dir : dirs) {
-            int nx = current.x() + dir.x();
-            int ny = current.y() + dir.y();
+void GameScene::chooseRepresentation()
+{
+    forceFlat = false;
+    if (memoryBudget <= 0) {
+        return;
+    }
 
-            if (nx > 0 && nx < COLS - 1 && ny > 0 && ny < ROWS - 1 && !visited[ny][nx]) {
-                neighbors.push_back(QPoint(nx, ny));
-            }
+    int walls = 0;
+    for (int i = 0; i < sim->rows() * sim->cols(); ++i) {
+        walls += sim->cellAt(i) == '1';
+    }
+    const int coins = sim->coinsLeft();
+    const int ghosts = int(sim->ghosts().size());
+    const qint64 cells = qint64(sim->rows()) * sim->cols();
+    const qint64 coinBitmap = ((cells + 63) / 64) * 8;
+
+    // 1. Per-tile items, byte-per-cell grid
+    if (estimateMemory(cells + coinBitmap, walls, coins, ghosts, isFlat()).total() <= memoryBudget) {
+        if (sim == &localGame) {
+            localGame.setPackedGrid(false);
         }
+        return;
+    }
 
-        if (neighbors.isEmpty()) {
-            stack.pop(); // Backtrack
-        } else {
-            QPoint next = neighbors.first();
-
-            int wallX = current.x() + (next.x() - current.x()) / 2;
-            int wallY = current.y() + (next.y() - current.y()) / 2;
-            maze[wallY][wallX] = '0';
+    // 2. Baked tile layer
+    if (!isFlat()) {
+        forceFlat = true;
+        qInfo() << "Level" << sim->level() << "over memory budget, using baked tile layer";
+    }
 
-            maze[next.y()][next.x()] = '0';
-            visited[next.y()][next.x()] = true;
-            stack.push(next);
+    // 3. Packed grid (only for our own game; watched sessions belong to their manager)
+    bool pack = estimateMemory(cells + coinBitmap, walls, coins, ghosts, true).total() > memoryBudget;
+    if (sim == &localGame && pack != localGame.isPackedGrid()) {
+        localGame.setPackedGrid(pack);
+        if (pack) {
+            qInfo() << "Level" << sim->level() << "over memory budget, packing maze grid";
         }
     }
 
-    populateMaze(gen);
+    // Level size is capped so this fits, except when even the smallest
+    // maze's tile layer (which still fills the view) is over the budget
+    qint64 total = estimateMemory(sim->memoryBytes(), walls, coins, ghosts, true).total();
+    if (total > memoryBudget) {
+        qWarning() << "Level" << sim->level() << "needs" << total << "bytes, over the"
+                   << memoryBudget << "byte memory budget";
+    }
 }
 
-void GameScene::populateMaze(std::mt19937& gen)
+GameScene::MemoryStats GameScene::estimateMemory(qint64 gridBytes, int walls, int coins, int ghosts, bool flat) const
 {
-    // 1. Add Loops (Alternative Paths)
-    std::uniform_int_distribution<> dist(0, 99);
-    int loopDensity = 15;
-
-    for (int r = 1; r < ROWS - 1; ++r) {
-        for (int c = 1; c < COLS - 1; ++c) {
-            if (maze[r][c] == '1') {
-                bool horizontal = (c > 0 && c < COLS - 1 && maze[r][c-1] == '0' && maze[r][c+1] == '0');
-                bool vertical = (r > 0 && r < ROWS - 1 && maze[r-1][c] == '0' && maze[r+1][c] == '0');
-
-                if ((horizontal || vertical) && dist(gen) < loopDensity) {
-                    maze[r][c] = '0';
-                }
-            }
-        }
+    MemoryStats m;
+    m.grid = gridBytes;
+
+    if (flat) {
+        const qint64 cells = qint64(sim->rows()) * sim->cols();
+        m.tileLayer = cells * gridStep * gridStep * 4 + ((cells + 63) / 64) * 8; // Image plus coin copy
+        m.entityItems = (ghosts + 1) * RectItemBytes;
+        m.sceneIndex = (ghosts + 2) * IndexBytesPerItem;
+    } else {
+        m.wallItems = walls * PixmapItemBytes;
+        m.coinItems = coins * (PixmapItemBytes + CoinMapNodeBytes);
+        m.entityItems = (ghosts + 1) * PixmapItemBytes;
+        // One shared scaled pixmap per sprite kind
+        m.pixmaps = AssetLoader::SpriteCount * qint64(gridStep) * gridStep * 4;
+        m.sceneIndex = (walls + coins + ghosts + 1) * IndexBytesPerItem;
     }
+    return m;
+}
 
-    // 2. Populate Coins
-    std::uniform_int_distribution<> coinDist(0, 6); // 1 in 7 chance
-    for (int r = 1; r < ROWS - 1; ++r) {
-        for (int c = 1; c < COLS - 1; ++c) {
-            if (maze[r][c] == '0' && QPoint(c, r) != playerStartPos) {
-                if (coinDist(gen) == 0) {
-                    maze[r][c] = '2';
-                }
-            }
-        }
+GameScene::MemoryStats GameScene::memoryStats() const
+{
+    MemoryStats m = estimateMemory(sim->memoryBytes(), int(wallItems.size()), int(coinItems.size()),
+                                   int(ghostSprites.size()), tileLayer != nullptr);
+    if (tileLayer) {
+        m.tileLayer = tileLayer->memoryBytes();
     }
+    return m;
+}
 
-    // 3. Place Exit
-    maze[ROWS - 2][COLS - 1] = 'E'; // 'E' = Exit
-    maze[ROWS - 2][COLS - 3] = '0';
-    maze[ROWS - 3][COLS - 2] = '0';
-
-    // 4. Place Ghosts
-    int ghostCount = std::min(currentLevel + 1, 10);
-    std::uniform_int_distribution<> rowDist(1, ROWS - 2);
-    std::uniform_int_distribution<> colDist(1, COLS - 2);
-    int minPlayerDist = (ROWS + COLS) / 4;
-
-    for (int i = 0; i < ghostCount; ++i) {
-        while (true) {
-            int r = rowDist(gen);
-            int c = colDist(gen);
-            int distToPlayer = abs(r - playerStartPos.y()) + abs(c - playerStartPos.x());
+void GameScene::dumpMemoryStats() const
+{
+    MemoryStats m = memoryStats();
+    qDebug().nospace() << "Memory (level " << sim->level() << ", "
+                       << sim->rows() << "x" << sim->cols() << ", "
+                       << (tileLayer ? "tile layer" : "tile items")
+                       << (sim->isPackedGrid() ? ", packed grid" : "") << "):";
+    qDebug() << "  grid       " << m.grid;
+    qDebug() << "  wallItems  " << m.wallItems;
+    qDebug() << "  coinItems  " << m.coinItems;
+    qDebug() << "  entities   " << m.entityItems;
+    qDebug() << "  pixmaps    " << m.pixmaps;
+    qDebug() << "  tileLayer  " << m.tileLayer;
+    qDebug() << "  sceneIndex " << m.sceneIndex;
+    qDebug() << "  total      " << m.total() << "of budget" << memoryBudget;
+}
 
-            if (maze[r][c] != '1' && distToPlayer > minPlayerDist) {
-                ghostStartPositions.append(QPoint(c, r));
-                break;
-            }
-        }
+void GameScene::updateMemoryOverlay()
+{
+    if (!memoryOverlay || !memoryOverlay->isVisible()) {
+        return;
     }
 
-    // 5. Place Player
-    maze[playerStartPos.y()][playerStartPos.x()] = 'P';
+    MemoryStats m = memoryStats();
+    auto kb = [](qint64 bytes) { return QString::number((bytes + 1023) / 1024) + " KB"; };
+    memoryOverlay->setText(
+        "grid " + kb(m.grid) + "\n" +
+        "walls " + kb(m.wallItems) + "\n" +
+        "coins " + kb(m.coinItems) + "\n" +
+        "entities " + kb(m.entityItems) + "\n" +
+        "pixmaps " + kb(m.pixmaps) + "\n" +
+        "tile layer " + kb(m.tileLayer) + "\n" +
+        "index " + kb(m.sceneIndex) + "\n" +
+        "total " + kb(m.total()) + " / " + kb(memoryBudget));
 }
 
 
 void GameScene::drawMaze()
 {
-    QPixmap wallPixmap(":/sprites/wall.png");
-    QPixmap coinPixmap(":/sprites/coin.png");
-    QPixmap playerPixmap(":/sprites/player.png");
+    if (isFlat()) {
+        drawMazeFlat();
+        return;
+    }
+
+    // Scale each sprite once; every tile item shares the same pixel data
+    QPixmap wallPixmap = assets->pixmap(AssetLoader::Wall).scaled(gridStep, gridStep);
+    QPixmap coinPixmap = assets->pixmap(AssetLoader::Coin).scaled(gridStep, gridStep);
+    QPixmap playerPixmap = assets->pixmap(AssetLoader::Player);
 
     playerSprite = addPixmap(playerPixmap.scaled(blockSize, blockSize));
     playerSprite->setFlag(QGraphicsItem::ItemIsFocusable, true);
@@ -225,18 +279,18 @@ void GameScene::drawMaze()
     playerSprite->setTransformOriginPoint(blockSize / 2, blockSize / 2);
     // --- END CHANGE ---
 
-    for (int i = 0; i < ROWS; ++i) {
-        for (int j = 0; j < COLS; ++j) {
+    for (int i = 0; i < sim->rows(); ++i) {
+        for (int j = 0; j < sim->cols(); ++j) {
             int x = j * gridStep + offsetX;
             int y = i * gridStep + offsetY;
 
-            if (maze[i][j] == '1') {
-                QGraphicsPixmapItem *wall = addPixmap(wallPixmap.scaled(gridStep, gridStep));
+            if (sim->cell(i, j) == '1') {
+                QGraphicsPixmapItem *wall = addPixmap(wallPixmap);
                 wall->setPos(x, y);
                 wallItems.push_back(wall);
             }
-            else if (maze[i][j] == '2') {
-                QGraphicsPixmapItem *coin = addPixmap(coinPixmap.scaled(gridStep, gridStep));
+            else if (sim->cell(i, j) == '2') {
+                QGraphicsPixmapItem *coin = addPixmap(coinPixmap);
                 coin->setPos(x, y);
                 coinItems[{i, j}] = coin;
             }
@@ -245,225 +299,281 @@ void GameScene::drawMaze()
     spawnGhosts();
 }
 
-void GameScene::initGame() {
-    currentDir = DirNone;
-    desiredDir = DirNone;
-    score = 0;
-    lives = 3;
+void GameScene::drawMazeFlat()
+{
+    // One baked image for walls and coins, one plain rect per entity
+    tileLayer = new TileLayerItem(*sim, gridStep,
+                                  assets->flatColor(AssetLoader::Wall),
+                                  assets->flatColor(AssetLoader::Coin));
+    tileLayer->setPos(offsetX, offsetY);
+    addItem(tileLayer);
+
+    playerSprite = addRect(0, 0, blockSize, blockSize, Qt::NoPen, assets->flatColor(AssetLoader::Player));
+    playerSprite->setFlag(QGraphicsItem::ItemIsFocusable, true);
+    setFocusItem(playerSprite);
+    playerSprite->setTransformOriginPoint(blockSize / 2, blockSize / 2);
 
-    emit scoreChanged(score, totalScore);
-    emit livesChanged(lives);
+    spawnGhosts();
+}
 
-    pos = playerStartPos;
-    setPlayerPos();
+void GameScene::initGame() {
+    resetInput();
+}
+
+void GameScene::resetInput() {
+    inputQueue.clear();
+    pendingTurns.clear();
+    staleDirs |= heldDirs;
+    heldDirs = 0;
 }
 
 void GameScene::spawnGhosts() {
-    QPixmap ghostPixmap(":/sprites/ghost.png");
+    if (isFlat()) {
+        QColor ghostColor = assets->flatColor(AssetLoader::Ghost);
+        for (int i = 0; i < int(sim->ghosts().size()); ++i) {
+            ghostSprites.push_back(addRect(0, 0, gridStep, gridStep, Qt::NoPen, ghostColor));
+        }
+        return;
+    }
 
-    for (const QPoint& gPos : ghostStartPositions) {
-        Ghost g;
-        g.pos = gPos;
-        g.dir = DirLeft;
-        g.sprite = addPixmap(ghostPixmap.scaled(gridStep, gridStep));
-        g.sprite->setPos(offsetX + g.pos.x()*gridStep, offsetY + g.pos.y()*gridStep);
-        ghosts.push_back(g);
+    QPixmap ghostPixmap = assets->pixmap(AssetLoader::Ghost).scaled(gridStep, gridStep);
+
+    for (int i = 0; i < int(sim->ghosts().size()); ++i) {
+        ghostSprites.push_back(addPixmap(ghostPixmap));
     }
 }
 
-void GameScene::keyReleaseEvent(QKeyEvent *event) {
-    Direction d = DirNone;
-    switch (event->key()) {
-    case Qt::Key_Left: case Qt::Key_A: d = DirLeft; break;
-    case Qt::Key_Right: case Qt::Key_D: d = DirRight; break;
-    case Qt::Key_Up: case Qt::Key_W: d = DirUp; break;
-    case Qt::Key_Down: case Qt::Key_S: d = DirDown; break;
-    default: QGraphicsScene::keyReleaseEvent(event); return;
-    }
-    desiredDir = d;
+Direction GameScene::keyToDirection(int key) {
+    switch (key) {
+    case Qt::Key_Left: case Qt::Key_A: return DirLeft;
+    case Qt::Key_Right: case Qt::Key_D: return DirRight;
+    case Qt::Key_Up: case Qt::Key_W: return DirUp;
+    case Qt::Key_Down: case Qt::Key_S: return DirDown;
+    default: return DirNone;
+    }
+}
+
+void GameScene::keyPressEvent(QKeyEvent *event) {
+    // Profiling: F3 toggles the memory overlay, F4 dumps it to the log
+    if (event->key() == Qt::Key_F3) {
+        if (!memoryOverlay) {
+            memoryOverlay = addSimpleText(QString());
+            memoryOverlay->setBrush(Qt::white);
+            memoryOverlay->setPos(10, 50);
+            memoryOverlay->setZValue(101);
+            memoryOverlay->hide();
+        }
+        memoryOverlay->setVisible(!memoryOverlay->isVisible());
+        updateMemoryOverlay();
+        return;
+    }
+    if (event->key() == Qt::Key_F4) {
+        dumpMemoryStats();
+        return;
+    }
+
+    Direction d = keyToDirection(event->key());
+    if (d == DirNone) {
+        QGraphicsScene::keyPressEvent(event);
+        return;
+    }
+    if (!event->isAutoRepeat() && !isWatching()) {
+        inputQueue.push({d, true, inputClock.nsecsElapsed()});
+    }
 }
 
-int GameScene::dx(Direction d) {
-    if (d == DirLeft) return -1;
-    if (d == DirRight) return 1;
-    return 0;
+void GameScene::keyReleaseEvent(QKeyEvent *event) {
+    Direction d = keyToDirection(event->key());
+    if (d == DirNone) {
+        QGraphicsScene::keyReleaseEvent(event);
+        return;
+    }
+    if (!event->isAutoRepeat() && !isWatching()) {
+        inputQueue.push({d, false, inputClock.nsecsElapsed()});
+    }
 }
-int GameScene::dy(Direction d) {
-    if (d == DirUp) return -1;
-    if (d == DirDown) return 1;
-    return 0;
+
+void GameScene::drainInput() {
+    InputEvent ev;
+    while (inputQueue.pop(ev)) {
+        int bit = 1 << ev.dir;
+        if (ev.pressed) {
+            heldDirs |= bit;
+            staleDirs &= ~bit;
+        } else if (heldDirs & bit) {
+            // Turn was already queued by its press
+            heldDirs &= ~bit;
+            continue;
+        } else if (staleDirs & bit) {
+            // Pressed before a level/life reset; that turn is gone
+            staleDirs &= ~bit;
+            continue;
+        }
+        // A press (or a release whose press we never saw, e.g. the key
+        // went down before the scene had focus) queues a turn
+        pendingTurns.push({ev.dir, ev.timeNs});
+    }
+
+    // Drop buffered turns that found no junction within the window
+    qint64 now = inputClock.nsecsElapsed();
+    while (turnBufferMs > 0 && !pendingTurns.isEmpty() &&
+           pendingTurns.front().dir != sim->playerDir() &&
+           now - pendingTurns.front().timeNs > qint64(turnBufferMs) * 1000000) {
+        PendingTurn dropped;
+        pendingTurns.pop(dropped);
+    }
+
+    // Standing still, a blocked turn would hold up the ones behind it
+    PendingTurn blocked;
+    while (sim->playerDir() == DirNone && pendingTurns.size() > 1) {
+        QPoint nxt = MazeSimulation::nextCell(sim->playerPos(), pendingTurns.front().dir);
+        if (!sim->isWall(nxt.y(), nxt.x())) {
+            break;
+        }
+        pendingTurns.pop(blocked);
+    }
 }
 
-QPoint GameScene::nextCell(const QPoint &pos, Direction dir) {
-    return QPoint(pos.x() + dx(dir), pos.y() + dy(dir));
+Direction GameScene::nextTurn() const {
+    return pendingTurns.isEmpty() ? DirNone : pendingTurns.front().dir;
 }
 
-bool GameScene::isWall(int row, int col) {
-    if (maze.isEmpty() || ROWS == 0 || COLS == 0) {
-        return true;
+void GameScene::takeTurn(int events) {
+    // The oldest turn is used up once the player moves in its direction;
+    // later turns wait for the next junction
+    if (!(events & MazeSimulation::EventMoved) || pendingTurns.isEmpty() ||
+        sim->playerDir() != pendingTurns.front().dir) {
+        return;
     }
-    if (row < 0 || col < 0 || row >= ROWS || col >= COLS) {
-        return true;
+    PendingTurn turn;
+    pendingTurns.pop(turn);
+
+    qint64 ns = inputClock.nsecsElapsed() - turn.timeNs;
+    latencyStats.samples++;
+    latencyStats.totalNs += ns;
+    latencyStats.maxNs = std::max(latencyStats.maxNs, ns);
+}
+
+void GameScene::reportInputLatency() {
+    if (latencyStats.samples > 0) {
+        qDebug().nospace() << "Input latency: "
+                           << latencyStats.samples << " turns, avg "
+                           << (latencyStats.totalNs / latencyStats.samples) / 1e6 << " ms, max "
+                           << latencyStats.maxNs / 1e6 << " ms, dropped "
+                           << inputQueue.overflows() << " events";
     }
-    return maze[row][col] == '1';
+    // Counts are per level
+    latencyStats = InputLatencyStats();
+    inputQueue.resetOverflows();
 }
 
 void GameScene::setPlayerPos() {
     if (playerSprite) {
+        QPoint pos = sim->playerPos();
         playerSprite->setPos(offsetX + pos.x() * gridStep, offsetY + pos.y() * gridStep);
     }
 }
 
-void GameScene::movePlayerTick() {
-    QPoint gridPos = QPoint(pos.x(), pos.y());
+void GameScene::syncFromSimulation() {
+    if (sim->levelSerial() != builtSerial) {
+        buildLevel(); // Calls back in once the new sprites exist
+        return;
+    }
 
-    if (desiredDir != DirNone && desiredDir != currentDir) {
-        if (tryChangeDirection(gridPos, currentDir, desiredDir)) {
-            currentDir = desiredDir;
-        }
+    setPlayerPos();
+
+    // --- CHANGE 2: APPLY ROTATION ---
+    // (Assuming your 'player.png' sprite faces right by default)
+    switch (sim->playerDir()) {
+    case DirRight:
+        playerSprite->setRotation(0);
+        break;
+    case DirLeft:
+        playerSprite->setRotation(180);
+        break;
+    case DirUp:
+        playerSprite->setRotation(270); // or -90
+        break;
+    case DirDown:
+        playerSprite->setRotation(90);
+        break;
+    default:
+        break; // No change if DirNone
     }
+    // --- END CHANGE ---
 
-    if (currentDir != DirNone) {
-        QPoint nxt = nextCell(gridPos, currentDir);
-        if (!isWall(nxt.y(), nxt.x())) {
-            pos = QPointF(nxt);
-            setPlayerPos();
-
-            // --- CHANGE 2: APPLY ROTATION ---
-            // (Assuming your 'player.png' sprite faces right by default)
-            switch (currentDir) {
-            case DirRight:
-                playerSprite->setRotation(0);
-                break;
-            case DirLeft:
-                playerSprite->setRotation(180);
-                break;
-            case DirUp:
-                playerSprite->setRotation(270); // or -90
-                break;
-            case DirDown:
-                playerSprite->setRotation(90);
-                break;
-            default:
-                break; // No change if DirNone
-            }
-            // --- END CHANGE ---
-
-            int cellY = pos.y();
-            int cellX = pos.x();
-
-            if (maze[cellY][cellX] == '2') {
-                maze[cellY][cellX] = '0';
-                QPair<int,int> key = {cellY, cellX};
-                if (coinItems.contains(key)) {
-                    removeItem(coinItems[key]);
-                    delete coinItems[key];
-                    coinItems.remove(key);
-                }
-
-                score++;
-                totalScore++;
-                emit scoreChanged(score, totalScore);
-            }
-            else if (maze[cellY][cellX] == 'E') {
-                gameTimer->stop();
-                loadLevel(currentLevel + 1);
-                return;
-            }
+    const std::vector<MazeSimulation::Ghost> &ghosts = sim->ghosts();
+    for (int i = 0; i < ghostSprites.size(); ++i) {
+        ghostSprites[i]->setPos(offsetX + ghosts[i].pos.x()*gridStep, offsetY + ghosts[i].pos.y()*gridStep);
+    }
 
-        } else {
-            currentDir = DirNone;
-        }
-    } else {
-        if (desiredDir != DirNone) {
-            QPoint nxt = nextCell(gridPos, desiredDir);
-            if (!isWall(nxt.y(), nxt.x())) {
-                currentDir = desiredDir;
-            }
+    if (sim->score() != shownScore || sim->total() != shownTotal) {
+        // Only a score that went up means coins left the maze; a reset
+        // (e.g. totalScore on game over) has no coin to clear
+        if (shownScore >= 0 && sim->score() > shownScore) {
+            removeCollectedCoins(sim->score() - shownScore);
         }
+        updateMemoryOverlay();
+        shownScore = sim->score();
+        shownTotal = sim->total();
+        emit scoreChanged(shownScore, shownTotal);
     }
-}
 
-void GameScene::moveEntities() {
-    gameTickCounter++;
-    movePlayerTick();
-    moveGhostsTick();
-
-    for (const Ghost &g : ghosts) {
-        if (g.pos == QPoint(pos.x(), pos.y())) {
-            lives--;
-            emit livesChanged(lives);
-            if (lives <= 0) {
-                gameTimer->stop();
-                totalScore = 0;
-                emit gameOver();
-            } else {
-                pos = playerStartPos;
-                setPlayerPos();
-                currentDir = DirNone;
-                desiredDir = DirNone;
-            }
-            break;
-        }
+    if (sim->livesLeft() != shownLives) {
+        shownLives = sim->livesLeft();
+        emit livesChanged(shownLives);
     }
 }
 
-bool GameScene::tryChangeDirection(QPoint gridPos, Direction from, Direction to) {
-    QPoint nxt = nextCell(gridPos, to);
-    return !isWall(nxt.y(), nxt.x());
-}
+void GameScene::removeCollectedCoins(int collected) {
+    if (tileLayer) {
+        tileLayer->syncCoins(sim->coinBitmap());
+        return;
+    }
 
-void GameScene::moveGhostsTick() {
-    // Speed Control Check
-    if (gameTickCounter % ghostMoveFrequency != 0) {
-        return; // Skip ghost movement for this tick
-    }
-
-    std::random_device rd;
-    std::mt19937 gen(rd());
-
-    for (Ghost &g : ghosts) {
-        QVector<Direction> options;
-        Direction oppositeDir = DirNone;
-        if (g.dir == DirLeft) oppositeDir = DirRight;
-        else if (g.dir == DirRight) oppositeDir = DirLeft;
-        else if (g.dir == DirUp) oppositeDir = DirDown;
-        else if (g.dir == DirDown) oppositeDir = DirUp;
-
-        for (Direction d : {DirLeft, DirRight, DirUp, DirDown}) {
-            QPoint nxt = nextCell(g.pos, d);
-            if (!isWall(nxt.y(), nxt.x())) {
-                if (d != oppositeDir) {
-                    options.push_back(d);
-                }
-            }
+    if (collected == 1) {
+        // One step takes at most one coin, so it's the last one
+        QPair<int,int> key = {sim->lastCoin().y(), sim->lastCoin().x()};
+        if (coinItems.contains(key)) {
+            removeItem(coinItems[key]);
+            delete coinItems[key];
+            coinItems.remove(key);
         }
+        return;
+    }
 
-        if (options.empty()) {
-            QPoint nxt = nextCell(g.pos, oppositeDir);
-            if (oppositeDir != DirNone && !isWall(nxt.y(), nxt.x())) {
-                options.push_back(oppositeDir);
-            }
+    // Several steps since the last sync (e.g. SessionManager::runTicks),
+    // so check every coin still on screen against the bitmap
+    const std::vector<quint64> &bits = sim->coinBitmap();
+    for (auto it = coinItems.begin(); it != coinItems.end();) {
+        int index = it.key().first * sim->cols() + it.key().second;
+        if (bits[index / 64] & (quint64(1) << (index % 64))) {
+            ++it;
+            continue;
         }
+        removeItem(it.value());
+        delete it.value();
+        it = coinItems.erase(it);
+    }
+}
 
-        if (!options.empty()) {
-            bool found = false;
-            for(Direction d : options) {
-                if(d == g.dir) {
-                    found = true;
-                    break;
-                }
-            }
+void GameScene::moveEntities() {
+    drainInput();
 
-            if (found && (rand() % 100 < 80)) {
-                // 80% chance to keep going straight
-            } else {
-                std::uniform_int_distribution<> dist(0, options.size()-1);
-                g.dir = options[dist(gen)];
-            }
+    int events = sim->step(nextTurn());
+    takeTurn(events);
+    if (events & MazeSimulation::EventLevelComplete) {
+        reportInputLatency();
+        initGame();
+    }
 
-            g.pos = nextCell(g.pos, g.dir);
-            g.sprite->setPos(offsetX + g.pos.x()*gridStep, offsetY + g.pos.y()*gridStep);
-        }
+    syncFromSimulation();
+
+    if (events & MazeSimulation::EventGameOver) {
+        gameTimer->stop();
+        reportInputLatency();
+        emit gameOver();
+    } else if (events & MazeSimulation::EventLifeLost) {
+        resetInput();
     }
 }
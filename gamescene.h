@@ -7,15 +7,64 @@
 #include <QVector>
 #include <QMap>
 #include <QPointF>
-#include <random> // Added for maze generation
+#include <QElapsedTimer>
+#include <QGraphicsSimpleTextItem>
+#include "mazesimulation.h"
+#include "assetloader.h"
+#include "tilelayer.h"
+#include "ringbuffer.h"
 
 class GameScene : public QGraphicsScene
 {
     Q_OBJECT
 
 public:
-    explicit GameScene(qreal x, qreal y, qreal width, qreal height, QObject *parent = nullptr);
+    explicit GameScene(qreal x, qreal y, qreal width, qreal height, AssetLoader *assets, QObject *parent = nullptr);
     void loadLevel(int levelNumber);
+    int tickInterval() const { return tickMs; }
+
+    // Render a session driven elsewhere (e.g. by SessionManager) instead of
+    // the scene's own game. Input is ignored while watching.
+    // Pass nullptr to go back to the local game.
+    void watchSession(MazeSimulation *session);
+
+    // Pre-turn window: how long (ms) a buffered turn waits for a junction.
+    // 0 keeps it until it can be taken.
+    void setTurnBufferWindow(int ms);
+
+    // Input-to-movement latency, measured from the key event timestamp
+    // to the tick where the player actually moves in that direction
+    struct InputLatencyStats {
+        int samples = 0;
+        qint64 totalNs = 0;
+        qint64 maxNs = 0;
+    };
+    InputLatencyStats inputLatency() const { return latencyStats; }
+
+    // Approximate bytes held by the level on screen, per subsystem.
+    // Shown with F3 (overlay) and F4 (debug dump).
+    struct MemoryStats {
+        qint64 grid = 0;        // Maze cells, coin bitmap, ghost state
+        qint64 wallItems = 0;
+        qint64 coinItems = 0;   // Items plus their lookup map
+        qint64 entityItems = 0; // Player and ghosts
+        qint64 pixmaps = 0;     // Scaled sprite pixel data
+        qint64 tileLayer = 0;   // Baked low-detail image
+        qint64 sceneIndex = 0;  // BSP index entries
+        qint64 total() const { return grid + wallItems + coinItems + entityItems + pixmaps + tileLayer + sceneIndex; }
+    };
+    MemoryStats memoryStats() const;
+    void dumpMemoryStats() const;
+
+    // Per-level memory budget in bytes, 0 for none. A level that would go
+    // over it is drawn as a baked tile layer, then its grid is packed.
+    // Levels stop growing at the size where that form, plus generating the
+    // next level, still fits. A budget below the smallest maze is logged.
+    void setMemoryBudget(qint64 bytes);
+
+public slots:
+    // Bring sprites in line with the simulation after it has been stepped
+    void syncFromSimulation();
 
 signals:
     // --- UPDATED SIGNAL ---
@@ -27,78 +76,96 @@ signals:
 
 
 protected:
+    void keyPressEvent(QKeyEvent *event) override;
     void keyReleaseEvent(QKeyEvent *event) override;
 
 private slots:
     void moveEntities();
 
 private:
+    AssetLoader *assets; // Decoded sprites
+
+    // Game rules/state; points at localGame unless watching a session
+    MazeSimulation localGame;
+    MazeSimulation *sim;
+    int builtSerial = -1; // levelSerial() the sprites were built for
+    int shownScore = -1;
+    int shownTotal = -1;
+    int shownLives = -1;
+
     // Game entities
-    QGraphicsPixmapItem *playerSprite;
+    QGraphicsItem *playerSprite;
     QMap<QPair<int, int>, QGraphicsPixmapItem*> coinItems;
-    QVector<QVector<char>> maze; // Using char
+    QVector<QGraphicsItem*> ghostSprites;
+
+    // Low-detail path: walls and coins baked into one image
+    TileLayerItem *tileLayer = nullptr;
+    int lodCellSize = 8; // Below this many pixels per cell, draw flat colours
+    bool forceFlat = false; // Flat colours because of the memory budget
+
+    // Memory accounting
+    qint64 memoryBudget = 0;
+    QGraphicsSimpleTextItem *memoryOverlay = nullptr;
 
     // To track walls for deletion
     QVector<QGraphicsPixmapItem*> wallItems;
 
     // Map dimensions
-    int COLS = 0;
-    int ROWS = 0;
     int gridStep = 40;
     int blockSize = 40;
     int offsetX = 0;
     int offsetY = 0;
 
-    // Player state
-    QPointF pos; // Player's grid position
-    enum Direction { DirNone = -1, DirLeft = 0, DirRight = 1, DirUp = 2, DirDown = 3 };
-    Direction currentDir;
-    Direction desiredDir;
-    QPoint playerStartPos;
+    // Input queue: key presses/releases in arrival order, drained every tick
+    struct InputEvent {
+        Direction dir;
+        bool pressed;
+        qint64 timeNs;
+    };
+    RingBuffer<InputEvent, 32> inputQueue;
+    QElapsedTimer inputClock;
+    int heldDirs = 0; // Bit per Direction currently held down
+    int staleDirs = 0; // Held across the last reset; their releases are ignored
+
+    // Turns waiting for a junction, oldest first; one is taken per junction.
+    // Two slots cover a quick corner (e.g. Up then Left) between ticks.
+    struct PendingTurn {
+        Direction dir;
+        qint64 timeNs; // Key event time, for latency
+    };
+    RingBuffer<PendingTurn, 2> pendingTurns;
+    int turnBufferMs = 0;
+    InputLatencyStats latencyStats;
 
     // Game state
     QTimer *gameTimer;
     int tickMs = 140;
-    int score = 0; // This will now be "level score"
-    int lives = 3;
-    int currentLevel = 1;
-
-    // --- NEW VARIABLES ---
-    int totalScore = 0;
-    int gameTickCounter = 0;
-    int ghostMoveFrequency = 3;
-    // --- END NEW ---
-
-    // Ghosts
-    struct Ghost {
-        QPoint pos;
-        Direction dir;
-        QGraphicsPixmapItem *sprite;
-    };
-    QVector<Ghost> ghosts;
-    QVector<QPoint> ghostStartPositions;
 
     // Helper functions
     void initGame();
-
-    // Maze Generation
-    void generateMaze(int rows, int cols);
-    void populateMaze(std::mt19937& gen);
+    void buildLevel();
 
     void drawMaze();
+    void drawMazeFlat();
+    bool isFlat() const { return forceFlat || gridStep < lodCellSize; }
+
+    void chooseRepresentation();
+    MemoryStats estimateMemory(qint64 gridBytes, int walls, int coins, int ghosts, bool flat) const;
+    void updateMemoryOverlay();
     void spawnGhosts();
 
     void clearLevelItems(); // Replaces clear()
+    void removeCollectedCoins(int collected);
 
-    void movePlayerTick();
-    void moveGhostsTick();
+    void drainInput();
+    Direction nextTurn() const;
+    void takeTurn(int events);
+    void resetInput();
+    void reportInputLatency();
+    Direction keyToDirection(int key);
 
     void setPlayerPos();
-    bool tryChangeDirection(QPoint gridPos, Direction from, Direction to);
-    bool isWall(int row, int col);
-    QPoint nextCell(const QPoint &pos, Direction dir);
-    int dx(Direction d);
-    int dy(Direction d);
+    bool isWatching() const { return sim != &localGame; }
 };
 
 #endif // GAMESCENE_H
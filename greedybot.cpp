@@ -0,0 +1,175 @@
+#include "greedybot.h"
+#include <algorithm> // for std::fill, std::min and std::reverse
+#include <cstdlib>
+
+qint64 GreedyBot::memoryBytesPerCell() const
+{
+    // seen, danger, parent, queue, and path at its reserved size
+    return 2 * sizeof(quint32) + 3 * sizeof(int);
+}
+
+Direction GreedyBot::act(const Observation &obs)
+{
+    const int cells = obs.rows * obs.cols;
+    if (int(seen.size()) < cells) {
+        seen.assign(cells, 0);
+        danger.assign(cells, 0);
+        parent.resize(cells);
+        queue.resize(cells);
+        path.reserve(cells);
+        stamp = 0;
+    }
+    if (obs.cols != cols) {
+        path.clear(); // New maze layout
+        cols = obs.cols;
+    }
+    if (++stamp == 0) {
+        // Stamp wrapped: start clean rather than trust stale marks
+        std::fill(seen.begin(), seen.end(), 0);
+        std::fill(danger.begin(), danger.end(), 0);
+        stamp = 1;
+    }
+
+    markDanger(obs);
+
+    if (!planIsValid(obs) && !plan(obs)) {
+        return flee(obs);
+    }
+    return stepTowards(obs, path[pathIndex++]);
+}
+
+void GreedyBot::markDanger(const Observation &obs)
+{
+    // Cells a ghost could reach next tick are off limits
+    for (int i = 0; i < obs.ghostCount; ++i) {
+        const QPoint &g = obs.ghosts[i];
+        danger[g.y() * obs.cols + g.x()] = stamp;
+        for (Direction d : {DirLeft, DirRight, DirUp, DirDown}) {
+            QPoint n = MazeSimulation::nextCell(g, d);
+            if (n.x() >= 0 && n.y() >= 0 && n.x() < obs.cols && n.y() < obs.rows) {
+                danger[n.y() * obs.cols + n.x()] = stamp;
+            }
+        }
+    }
+}
+
+bool GreedyBot::planIsValid(const Observation &obs) const
+{
+    if (pathIndex >= int(path.size())) {
+        return false;
+    }
+
+    // Player must be where the plan expects (a lost life resets it)
+    int here = obs.player.y() * obs.cols + obs.player.x();
+    int expected = pathIndex > 0 ? path[pathIndex - 1] : -1;
+    if (here != expected) {
+        return false;
+    }
+
+    // Target must still be a coin or the exit (a new level replaces the grid)
+    char target = obs.cellAt(path.back());
+    if (target != '2' && target != 'E') {
+        return false;
+    }
+
+    // Re-plan if a ghost is about to cross the next couple of steps
+    int lookahead = std::min(int(path.size()), pathIndex + 2);
+    for (int i = pathIndex; i < lookahead; ++i) {
+        if (danger[path[i]] == stamp) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool GreedyBot::plan(const Observation &obs)
+{
+    path.clear();
+    pathIndex = 0;
+
+    const int start = obs.player.y() * obs.cols + obs.player.x();
+    int head = 0;
+    int tail = 0;
+    queue[tail++] = start;
+    seen[start] = stamp;
+
+    int target = -1;
+    int exitCell = -1;
+    while (head < tail) {
+        int cur = queue[head++];
+        if (cur != start) {
+            if (obs.cellAt(cur) == '2') {
+                target = cur; // Nearest coin
+                break;
+            }
+            if (obs.cellAt(cur) == 'E' && exitCell < 0) {
+                exitCell = cur;
+            }
+        }
+
+        int row = cur / obs.cols;
+        int col = cur % obs.cols;
+        for (Direction d : {DirLeft, DirRight, DirUp, DirDown}) {
+            int r = row + MazeSimulation::dy(d);
+            int c = col + MazeSimulation::dx(d);
+            if (r < 0 || c < 0 || r >= obs.rows || c >= obs.cols) {
+                continue;
+            }
+            int next = r * obs.cols + c;
+            if (seen[next] == stamp || danger[next] == stamp || obs.cellAt(next) == '1') {
+                continue;
+            }
+            seen[next] = stamp;
+            parent[next] = cur;
+            queue[tail++] = next;
+        }
+    }
+
+    // No reachable coin: head for the exit
+    if (target < 0) {
+        target = exitCell;
+    }
+    if (target < 0) {
+        return false;
+    }
+
+    for (int cell = target; cell != start; cell = parent[cell]) {
+        path.push_back(cell);
+    }
+    std::reverse(path.begin(), path.end());
+    return true;
+}
+
+Direction GreedyBot::stepTowards(const Observation &obs, int cell) const
+{
+    int row = cell / obs.cols;
+    int col = cell % obs.cols;
+    if (row < obs.player.y()) return DirUp;
+    if (row > obs.player.y()) return DirDown;
+    if (col < obs.player.x()) return DirLeft;
+    if (col > obs.player.x()) return DirRight;
+    return DirNone;
+}
+
+Direction GreedyBot::flee(const Observation &obs) const
+{
+    Direction best = DirNone;
+    int bestDist = -1;
+    for (Direction d : {DirLeft, DirRight, DirUp, DirDown}) {
+        QPoint n = MazeSimulation::nextCell(obs.player, d);
+        if (n.x() < 0 || n.y() < 0 || n.x() >= obs.cols || n.y() >= obs.rows ||
+            obs.cellAt(n.y() * obs.cols + n.x()) == '1') {
+            continue;
+        }
+        int nearest = obs.rows + obs.cols;
+        for (int i = 0; i < obs.ghostCount; ++i) {
+            int dist = abs(obs.ghosts[i].x() - n.x()) + abs(obs.ghosts[i].y() - n.y());
+            nearest = std::min(nearest, dist);
+        }
+        if (nearest > bestDist) {
+            bestDist = nearest;
+            best = d;
+        }
+    }
+    return best;
+}
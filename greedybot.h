@@ -0,0 +1,37 @@
+#ifndef GREEDYBOT_H
+#define GREEDYBOT_H
+
+#include "bot.h"
+#include <vector>
+
+// Baseline bot: BFS to the nearest coin (then the exit), never stepping
+// into or next to a ghost. The path is kept between ticks and only
+// re-planned when it is used up, its target is gone or a ghost gets in
+// the way. All buffers are reused, so act() only allocates when a bigger
+// maze shows up.
+class GreedyBot : public Bot
+{
+public:
+    Direction act(const Observation &obs) override;
+    qint64 memoryBytesPerCell() const override;
+
+private:
+    std::vector<quint32> seen;     // Stamp per cell: visited this search
+    std::vector<quint32> danger;   // Stamp per cell: ghost or next to one
+    std::vector<int> parent;       // BFS tree, to walk a path back
+    std::vector<int> queue;
+    quint32 stamp = 0;
+
+    // Current plan: cells from the player (exclusive) to the target
+    std::vector<int> path;
+    int pathIndex = 0;
+    int cols = 0;
+
+    void markDanger(const Observation &obs);
+    bool planIsValid(const Observation &obs) const;
+    bool plan(const Observation &obs);
+    Direction stepTowards(const Observation &obs, int cell) const;
+    Direction flee(const Observation &obs) const;
+};
+
+#endif // GREEDYBOT_H
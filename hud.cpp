@@ -0,0 +1,90 @@
+#include "hud.h"
+#include <QPainter>
+#include <QApplication>
+#include <QTransform>
+
+HudItem::HudItem(qreal width, QGraphicsItem *parent)
+    : QGraphicsItem(parent), width(width)
+{
+    // Same layout the old proxy-widget labels used
+    entries[FieldLevel] = { "Level: ", 1, QPointF(10, 5), QStaticText(), true };
+    entries[FieldCoins] = { "Coins: ", 0, QPointF(10, 25), QStaticText(), true };
+    entries[FieldLives] = { "Lives: ", 3, QPointF(width - 80, 5), QStaticText(), true };
+    entries[FieldTotal] = { "Total: ", 0, QPointF(width - 80, 25), QStaticText(), true };
+
+    for (Entry &e : entries) {
+        e.text.setTextFormat(Qt::PlainText);
+        e.text.setPerformanceHint(QStaticText::AggressiveCaching);
+    }
+
+    QFont f = QApplication::font();
+    f.setBold(true);
+    hudFont = f;
+
+    // Always on top of the maze, never takes focus or mouse input
+    setZValue(100);
+    setAcceptedMouseButtons(Qt::NoButton);
+}
+
+void HudItem::setLevel(int level) { setField(FieldLevel, level); }
+void HudItem::setCoins(int coins) { setField(FieldCoins, coins); }
+void HudItem::setTotal(int total) { setField(FieldTotal, total); }
+void HudItem::setLives(int lives) { setField(FieldLives, lives); }
+
+void HudItem::setFont(const QFont &font)
+{
+    hudFont = font;
+    hudFont.setBold(true);
+    for (Entry &e : entries) {
+        e.dirty = true;
+    }
+    scheduleRepaint();
+}
+
+void HudItem::setField(Field field, int value)
+{
+    Entry &e = entries[field];
+    if (e.value == value) {
+        return;
+    }
+    e.value = value;
+    e.dirty = true;
+    scheduleRepaint();
+}
+
+void HudItem::scheduleRepaint()
+{
+    // update() already gets merged by the scene, but skipping the call
+    // keeps a burst of pickups from walking the update path repeatedly
+    if (repaintPending) {
+        return;
+    }
+    repaintPending = true;
+    update();
+}
+
+QRectF HudItem::boundingRect() const
+{
+    return QRectF(0, 0, width, 50);
+}
+
+void HudItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    Q_UNUSED(option);
+    Q_UNUSED(widget);
+
+    repaintPending = false;
+
+    painter->setFont(hudFont);
+    painter->setPen(Qt::white);
+
+    for (Entry &e : entries) {
+        // Only rebuild the glyph run for values that actually changed
+        if (e.dirty) {
+            e.text.setText(QLatin1String(e.label) + QString::number(e.value));
+            e.text.prepare(QTransform(), hudFont);
+            e.dirty = false;
+        }
+        painter->drawStaticText(e.pos, e.text);
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef HUD_H
+#define HUD_H
+
+#include <QGraphicsItem>
+#include <QStaticText>
+#include <QFont>
+
+// Lightweight heads-up display drawn straight into the scene.
+// Each field keeps its text as a prepared QStaticText, so painting is just
+// a glyph-run blit. Setters only mark fields dirty; any number of changes
+// between two frames collapse into a single repaint.
+class HudItem : public QGraphicsItem
+{
+public:
+    explicit HudItem(qreal width, QGraphicsItem *parent = nullptr);
+
+    void setLevel(int level);
+    void setCoins(int coins);
+    void setTotal(int total);
+    void setLives(int lives);
+    void setFont(const QFont &font);
+
+    QRectF boundingRect() const override;
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = nullptr) override;
+
+private:
+    enum Field { FieldLevel = 0, FieldCoins, FieldLives, FieldTotal, FieldCount };
+
+    struct Entry {
+        const char *label;
+        int value;
+        QPointF pos;
+        QStaticText text;
+        bool dirty;
+    };
+
+    void setField(Field field, int value);
+    void scheduleRepaint();
+
+    Entry entries[FieldCount];
+    QFont hudFont;
+    qreal width;
+    bool repaintPending = false;
+};
+
+#endif // HUD_H
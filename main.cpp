@@ -1,22 +1,53 @@
 #include "mainwindow.h"
+#include "botdriver.h"
+#include "greedybot.h"
+#include "assetloader.h"
+#include "startuptimer.h"
 #include <QApplication>
-#include <QFontDatabase>
 #include <QDebug>
 
+// Headless run of the baseline bot, prints simulation throughput
+static int runBotBench(quint64 ticks)
+{
+    MazeSimulation sim;
+    GreedyBot bot;
+    BotDriver::Result r = BotDriver::run(sim, bot, ticks);
+
+    qInfo().nospace() << "Bot bench: " << r.ticks << " ticks in "
+                      << r.elapsedNs / 1e6 << " ms (" << qint64(r.ticksPerSecond) << " ticks/s), "
+                      << r.games << " games over, best level " << r.bestLevel
+                      << ", best total " << r.bestTotal;
+    return 0;
+}
+
 int main(int argc, char *argv[])
 {
+    StartupTimer::begin();
+
+    // Mage --bot-bench [ticks]: no window, no QApplication needed
+    for (int i = 1; i < argc; ++i) {
+        if (qstrcmp(argv[i], "--bot-bench") == 0) {
+            quint64 ticks = (i + 1 < argc) ? QByteArray(argv[i + 1]).toULongLong() : 0;
+            return runBotBench(ticks > 0 ? ticks : 1000000);
+        }
+    }
+
     QApplication a(argc, argv);
 
-    // Load the pixel font
-    int fontId = QFontDatabase::addApplicationFont(":/fonts/pixel-font.ttf");
-    if (fontId != -1) {
-        QString fontFamily = QFontDatabase::applicationFontFamilies(fontId).at(0);
-        a.setFont(QFont(fontFamily, 12)); // Set as default
-    } else {
-        qWarning() << "Could not load pixel font!";
+    // Decode sprites and the pixel font while the menu comes up
+    AssetLoader assets;
+    assets.start();
+    QObject::connect(&assets, &AssetLoader::loaded, []() { StartupTimer::mark("assets loaded"); });
+
+    MainWindow w(&assets);
+
+    // Mage --attract [sessions]: bots play in the background, one is shown
+    int attract = a.arguments().indexOf("--attract");
+    if (attract > 0) {
+        int sessions = a.arguments().value(attract + 1).toInt();
+        w.startAttractMode(sessions > 0 ? sessions : 100);
     }
 
-    MainWindow w;
     w.show();
     return a.exec();
-}
\ No newline at end of file
+}
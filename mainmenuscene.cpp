@@ -12,22 +12,32 @@ MainMenuScene::MainMenuScene(qreal x, qreal y, qreal width, qreal height, QObjec
 
     // Add Title
     titleText = new QGraphicsTextItem("MAZE GAME");
-    QFont titleFont = font();
-    titleFont.setPointSize(48);
-    titleFont.setBold(true);
-    titleText->setFont(titleFont);
     titleText->setDefaultTextColor(Qt::yellow);
-    titleText->setPos((width - titleText->boundingRect().width()) / 2, height / 2 - 100);
     addItem(titleText);
 
     // Add Start Button
     startButton = new QGraphicsTextItem("START");
-    QFont buttonFont = font();
+    startButton->setDefaultTextColor(Qt::white);
+    addItem(startButton);
+
+    applyFont(font());
+}
+
+void MainMenuScene::applyFont(const QFont &font)
+{
+    qreal width = sceneRect().width();
+    qreal height = sceneRect().height();
+
+    QFont titleFont = font;
+    titleFont.setPointSize(48);
+    titleFont.setBold(true);
+    titleText->setFont(titleFont);
+    titleText->setPos((width - titleText->boundingRect().width()) / 2, height / 2 - 100);
+
+    QFont buttonFont = font;
     buttonFont.setPointSize(24);
     startButton->setFont(buttonFont);
-    startButton->setDefaultTextColor(Qt::white);
     startButton->setPos((width - startButton->boundingRect().width()) / 2, height / 2 + 20);
-    addItem(startButton);
 }
 
 void MainMenuScene::mousePressEvent(QGraphicsSceneMouseEvent *event)
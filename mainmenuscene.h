@@ -12,6 +12,9 @@ class MainMenuScene : public QGraphicsScene
 public:
     explicit MainMenuScene(qreal x, qreal y, qreal width, qreal height, QObject *parent = nullptr);
 
+    // Re-style and re-centre the texts once the pixel font has loaded
+    void applyFont(const QFont &font);
+
 signals:
     void startGameClicked();
 
@@ -1,9 +1,12 @@
 #include "mainwindow.h"
 #include <QVBoxLayout>
-#include <QGraphicsProxyWidget>
+#include <QRandomGenerator>
+#include <QEvent>
+#include "startuptimer.h"
+#include "greedybot.h"
 
-MainWindow::MainWindow(QWidget *parent)
-    : QMainWindow(parent)
+MainWindow::MainWindow(AssetLoader *assets, QWidget *parent)
+    : QMainWindow(parent), assets(assets)
 {
     // 1. Create the main view
     view = new QGraphicsView(this);
@@ -11,63 +14,22 @@ MainWindow::MainWindow(QWidget *parent)
     view->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
     view->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
     view->setFixedSize(SCENE_WIDTH + 2, SCENE_HEIGHT + 2); // +2 for border
+    view->viewport()->installEventFilter(this);
 
-    // 2. Create the scenes
+    // 2. Create the menu; the game scene waits until it's needed
     mainMenuScene = new MainMenuScene(0, 0, SCENE_WIDTH, SCENE_HEIGHT, this);
-    gameScene = new GameScene(0, 0, SCENE_WIDTH, SCENE_HEIGHT, this);
-
-    // 3. Create UI elements
-    levelLabel = new QLabel("Level: 1");
-    levelLabel->setAttribute(Qt::WA_TranslucentBackground);
-    levelLabel->setStyleSheet("color: white; font-weight: bold;");
-
-    scoreLabel = new QLabel("Coins: 0");
-    scoreLabel->setAttribute(Qt::WA_TranslucentBackground);
-    scoreLabel->setStyleSheet("color: white; font-weight: bold;");
-
-    livesLabel = new QLabel("Lives: 3");
-    livesLabel->setAttribute(Qt::WA_TranslucentBackground);
-    livesLabel->setStyleSheet("color: white; font-weight: bold;");
-
-    totalScoreLabel = new QLabel("Total: 0");
-    totalScoreLabel->setAttribute(Qt::WA_TranslucentBackground);
-    totalScoreLabel->setStyleSheet("color: white; font-weight: bold;");
-
-    // 4. Add UI to the GameScene
-    QGraphicsProxyWidget *levelProxy = gameScene->addWidget(levelLabel);
-    QGraphicsProxyWidget *scoreProxy = gameScene->addWidget(scoreLabel);
-    QGraphicsProxyWidget *livesProxy = gameScene->addWidget(livesLabel);
-    QGraphicsProxyWidget *totalScoreProxy = gameScene->addWidget(totalScoreLabel);
-
-    // Arrange UI
-    levelProxy->setPos(10, 5);
-    scoreProxy->setPos(10, 25);
-    livesProxy->setPos(SCENE_WIDTH - 80, 5);
-    totalScoreProxy->setPos(SCENE_WIDTH - 80, 25);
-
-    // --- THIS IS THE BUG FIX ---
-    // Set a high Z-value to ensure UI is drawn on top of the maze
-    levelProxy->setZValue(100);
-    scoreProxy->setZValue(100);
-    livesProxy->setZValue(100);
-    totalScoreProxy->setZValue(100);
-    // --- END FIX ---
-
-    // 5. Set up the central widget and layout
+
+    // 3. Set up the central widget and layout
     QWidget *centralWidget = new QWidget(this);
     QVBoxLayout *layout = new QVBoxLayout(centralWidget);
     layout->addWidget(view);
     setCentralWidget(centralWidget);
 
-    // 6. Connect signals
+    // 4. Connect signals
     connect(mainMenuScene, &MainMenuScene::startGameClicked, this, &MainWindow::startGame);
-    connect(gameScene, &GameScene::scoreChanged, this, &MainWindow::updateScore);
-    connect(gameScene, &GameScene::livesChanged, this, &MainWindow::updateLives);
-    connect(gameScene, &GameScene::gameOver, this, &MainWindow::showMainMenu);
-    // --- NEW CONNECTION ---
-    connect(gameScene, &GameScene::levelChanged, this, &MainWindow::updateLevel);
+    connect(assets, &AssetLoader::fontLoaded, this, &MainWindow::applyFont);
 
-    // 7. Start with the main menu
+    // 5. Start with the main menu
     showMainMenu();
 
     // Set fixed window size
@@ -79,33 +41,110 @@ MainWindow::~MainWindow()
 {
 }
 
+void MainWindow::ensureGameScene()
+{
+    if (gameScene) {
+        return;
+    }
+
+    gameScene = new GameScene(0, 0, SCENE_WIDTH, SCENE_HEIGHT, assets, this);
+
+    // HUD painted directly as a scene item (no proxy widgets / QLabel relayout)
+    hud = new HudItem(SCENE_WIDTH);
+    gameScene->addItem(hud);
+
+    connect(gameScene, &GameScene::scoreChanged, this, &MainWindow::updateScore);
+    connect(gameScene, &GameScene::livesChanged, this, &MainWindow::updateLives);
+    connect(gameScene, &GameScene::gameOver, this, &MainWindow::showMainMenu);
+    // --- NEW CONNECTION ---
+    connect(gameScene, &GameScene::levelChanged, this, &MainWindow::updateLevel);
+}
+
+void MainWindow::applyFont(const QFont &font)
+{
+    mainMenuScene->applyFont(font);
+    if (hud) {
+        hud->setFont(font);
+    }
+}
+
+bool MainWindow::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched == view->viewport() && event->type() == QEvent::Paint) {
+        if (view->scene() == mainMenuScene) {
+            StartupTimer::mark("first menu frame");
+        } else if (gameScene && view->scene() == gameScene) {
+            if (playing) {
+                StartupTimer::mark("first playable frame");
+                StartupTimer::report();
+            } else {
+                StartupTimer::mark("first attract frame");
+            }
+        }
+    }
+    return QMainWindow::eventFilter(watched, event);
+}
+
 void MainWindow::showMainMenu()
 {
+    playing = false;
     view->setScene(mainMenuScene);
     mainMenuScene->setFocus();
 }
 
 void MainWindow::startGame()
 {
+    if (sessionManager) {
+        sessionManager->stop();
+    }
+    ensureGameScene();
+    playing = true;
     gameScene->loadLevel(1); // Start level 1
     view->setScene(gameScene);
     gameScene->setFocus();
 }
 
+void MainWindow::startAttractMode(int sessionCount)
+{
+    ensureGameScene();
+    playing = false;
+    if (!sessionManager) {
+        sessionManager = new SessionManager(sessionCount, QRandomGenerator::global()->generate64(), this);
+        for (int i = 0; i < sessionManager->count(); ++i) {
+            sessionManager->setBot(i, std::make_unique<GreedyBot>());
+        }
+        sessionManager->setMaxLevelSize(SCENE_HEIGHT, SCENE_WIDTH);
+        connect(sessionManager, &SessionManager::watchedStepped, gameScene, &GameScene::syncFromSimulation);
+        connect(sessionManager, &SessionManager::watchedChanged, this, &MainWindow::showSession);
+    }
+
+    gameScene->watchSession(sessionManager->watchedSession());
+    view->setScene(gameScene);
+    sessionManager->start(gameScene->tickInterval());
+}
+
+void MainWindow::showSession(MazeSimulation *session)
+{
+    // Only follow the switch while attract mode is on screen, not over a real game
+    if (sessionManager && sessionManager->isRunning()) {
+        gameScene->watchSession(session);
+    }
+}
+
 // --- UPDATED SLOT ---
 void MainWindow::updateScore(int levelScore, int totalScore)
 {
-    scoreLabel->setText("Coins: " + QString::number(levelScore));
-    totalScoreLabel->setText("Total: " + QString::number(totalScore));
+    hud->setCoins(levelScore);
+    hud->setTotal(totalScore);
 }
 
 void MainWindow::updateLives(int lives)
 {
-    livesLabel->setText("Lives: " + QString::number(lives));
+    hud->setLives(lives);
 }
 
 // --- NEW SLOT ---
 void MainWindow::updateLevel(int level)
 {
-    levelLabel->setText("Level: " + QString::number(level));
+    hud->setLevel(level);
 }
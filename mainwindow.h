@@ -3,18 +3,27 @@
 
 #include <QMainWindow>
 #include <QGraphicsView>
-#include <QLabel>
 #include "gamescene.h"
 #include "mainmenuscene.h"
+#include "hud.h"
+#include "sessionmanager.h"
+#include "assetloader.h"
 
 class MainWindow : public QMainWindow
 {
     Q_OBJECT
 
 public:
-    MainWindow(QWidget *parent = nullptr);
+    MainWindow(AssetLoader *assets, QWidget *parent = nullptr);
     ~MainWindow();
 
+    // Run sessionCount bot-driven games and show one of them
+    void startAttractMode(int sessionCount);
+
+protected:
+    // Spots the first painted frame of each scene for startup timing
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
 private slots:
     void showMainMenu();
     void startGame();
@@ -23,19 +32,20 @@ private slots:
     void updateLives(int lives);
     // --- NEW SLOT ---
     void updateLevel(int level);
-
+    void applyFont(const QFont &font);
+    void showSession(MazeSimulation *session);
 
 private:
     QGraphicsView *view;
-    GameScene *gameScene;
+    GameScene *gameScene = nullptr; // Built on first use, see ensureGameScene()
     MainMenuScene *mainMenuScene;
+    SessionManager *sessionManager = nullptr;
+    AssetLoader *assets;
 
-    QLabel *scoreLabel; // "Coins"
-    QLabel *livesLabel;
+    HudItem *hud = nullptr; // Level, coins, lives and total
+    bool playing = false; // The game scene holds the player's game, not a bot preview
 
-    // --- NEW LABELS ---
-    QLabel *totalScoreLabel;
-    QLabel *levelLabel;
+    void ensureGameScene();
 
     // Define game area size
     const int SCENE_WIDTH = 800;
@@ -0,0 +1,434 @@
+#include "mazesimulation.h"
+#include "bot.h"
+#include <algorithm> // for std::max, std::min and std::shuffle
+#include <cstdlib>
+#include <cmath>
+#include <cstring>
+
+// Per-cell cost of a level, the peak being while the next one is generated
+static const qint64 GenerationBytesPerCell = 4; // Grid 1, visited 1, QPoint DFS stack ~2
+static const qint64 BitmapBytesPerCell = 1;     // Packed grid 0.5, coin bitmap 0.125, rounded up
+
+MazeSimulation::MazeSimulation(quint64 seed)
+    : gen(static_cast<std::mt19937::result_type>(seed ^ (seed >> 32)))
+{
+    setMemoryBudget(DefaultMemoryBudget);
+}
+
+void MazeSimulation::setMemoryBudget(qint64 bytes, qint64 extraBytesPerCell)
+{
+    budget = std::max<qint64>(0, bytes);
+    maxCells = budget / (GenerationBytesPerCell + BitmapBytesPerCell + std::max<qint64>(0, extraBytesPerCell));
+}
+
+void MazeSimulation::newGame()
+{
+    totalScore = 0;
+    loadLevel(1);
+}
+
+void MazeSimulation::loadLevel(int levelNumber)
+{
+    ghostList.clear();
+    ghostStartPositions.clear();
+
+    currentLevel = levelNumber;
+    serial++;
+
+    // Ghost speed scaling
+    ghostMoveFrequency = std::max(1, 3 - (levelNumber - 1));
+    gameTickCounter = 0;
+
+    // Maze size formula
+    int mazeRows = 17 + (levelNumber - 1) * 6;
+    int mazeCols = 25 + (levelNumber - 1) * 8;
+
+    // Shrink both sides evenly (rounding down to odd) to stay under the cap
+    if (maxCells > 0 && qint64(mazeRows) * mazeCols > maxCells) {
+        double scale = std::sqrt(double(maxCells) / (double(mazeRows) * mazeCols));
+        mazeRows = std::max(17, (int(mazeRows * scale) - 1) | 1);
+        mazeCols = std::max(25, (int(mazeCols * scale) - 1) | 1);
+    }
+    if (maxRows > 0) {
+        mazeRows = std::max(17, std::min(mazeRows, (maxRows - 1) | 1));
+    }
+    if (maxCols > 0) {
+        mazeCols = std::max(25, std::min(mazeCols, (maxCols - 1) | 1));
+    }
+
+    packed = false;
+    packedMaze.clear();
+    generateMaze(mazeRows, mazeCols);
+    if (packRequested) {
+        packGrid();
+    }
+
+    for (const QPoint &gPos : ghostStartPositions) {
+        ghostList.push_back({gPos, DirLeft});
+    }
+
+    currentDir = DirNone;
+    levelScore = 0;
+    lives = 3;
+    gameOver = false;
+    pos = playerStartPos;
+    lastCoinPos = QPoint(-1, -1);
+}
+
+void MazeSimulation::generateMaze(int rows, int cols)
+{
+    ROWS = rows;
+    COLS = cols;
+    maze.assign(ROWS * COLS, '1'); // 1 = Wall
+
+    std::vector<char> visited(ROWS * COLS, 0);
+    std::vector<QPoint> stack;
+    stack.reserve((ROWS / 2) * (COLS / 2));
+
+    // 1. Start DFS from (1, 1)
+    playerStartPos = QPoint(1, 1);
+    stack.push_back(playerStartPos);
+    at(1, 1) = '0'; // 0 = Path
+    visited[1 * COLS + 1] = 1;
+
+    QPoint dirs[4] = {{0, -2}, {0, 2}, {-2, 0}, {2, 0}};
+
+    while (!stack.empty()) {
+        QPoint current = stack.back();
+
+        std::shuffle(dirs, dirs + 4, gen);
+        bool carved = false;
+        for (const QPoint &dir : dirs) {
+            int nx = current.x() + dir.x();
+            int ny = current.y() + dir.y();
+
+            if (nx > 0 && nx < COLS - 1 && ny > 0 && ny < ROWS - 1 && !visited[ny * COLS + nx]) {
+                at(current.y() + dir.y() / 2, current.x() + dir.x() / 2) = '0';
+                at(ny, nx) = '0';
+                visited[ny * COLS + nx] = 1;
+                stack.push_back(QPoint(nx, ny));
+                carved = true;
+                break;
+            }
+        }
+
+        if (!carved) {
+            stack.pop_back(); // Backtrack
+        }
+    }
+
+    populateMaze();
+}
+
+void MazeSimulation::populateMaze()
+{
+    // 1. Add Loops (Alternative Paths)
+    std::uniform_int_distribution<> dist(0, 99);
+    int loopDensity = 15;
+
+    for (int r = 1; r < ROWS - 1; ++r) {
+        for (int c = 1; c < COLS - 1; ++c) {
+            if (at(r, c) == '1') {
+                bool horizontal = (at(r, c - 1) == '0' && at(r, c + 1) == '0');
+                bool vertical = (at(r - 1, c) == '0' && at(r + 1, c) == '0');
+
+                if ((horizontal || vertical) && dist(gen) < loopDensity) {
+                    at(r, c) = '0';
+                }
+            }
+        }
+    }
+
+    // 2. Populate Coins
+    std::uniform_int_distribution<> coinDist(0, 6); // 1 in 7 chance
+    for (int r = 1; r < ROWS - 1; ++r) {
+        for (int c = 1; c < COLS - 1; ++c) {
+            if (at(r, c) == '0' && QPoint(c, r) != playerStartPos) {
+                if (coinDist(gen) == 0) {
+                    at(r, c) = '2';
+                }
+            }
+        }
+    }
+
+    // 3. Place Exit
+    at(ROWS - 2, COLS - 1) = 'E'; // 'E' = Exit
+    at(ROWS - 2, COLS - 3) = '0';
+    at(ROWS - 3, COLS - 2) = '0';
+
+    // 4. Place Ghosts
+    int ghostCount = std::min(currentLevel + 1, 10);
+    std::uniform_int_distribution<> rowDist(1, ROWS - 2);
+    std::uniform_int_distribution<> colDist(1, COLS - 2);
+    int minPlayerDist = (ROWS + COLS) / 4;
+
+    for (int i = 0; i < ghostCount; ++i) {
+        while (true) {
+            int r = rowDist(gen);
+            int c = colDist(gen);
+            int distToPlayer = abs(r - playerStartPos.y()) + abs(c - playerStartPos.x());
+
+            if (at(r, c) != '1' && distToPlayer > minPlayerDist) {
+                ghostStartPositions.push_back(QPoint(c, r));
+                break;
+            }
+        }
+    }
+
+    // 5. Place Player
+    at(playerStartPos.y(), playerStartPos.x()) = 'P';
+
+    // 6. Coin bitmap for bot observations
+    coinBits.assign((ROWS * COLS + 63) / 64, 0);
+    coinCount = 0;
+    for (int i = 0; i < ROWS * COLS; ++i) {
+        if (maze[i] == '2') {
+            coinBits[i / 64] |= quint64(1) << (i % 64);
+            coinCount++;
+        }
+    }
+}
+
+void MazeSimulation::setPackedGrid(bool on)
+{
+    packRequested = on;
+    if (maze.empty() && packedMaze.empty()) {
+        return; // Applied by the next loadLevel
+    }
+    if (on && !packed) {
+        packGrid();
+    } else if (!on && packed) {
+        unpackGrid();
+    }
+}
+
+void MazeSimulation::packGrid()
+{
+    const int cells = ROWS * COLS;
+    packedMaze.assign((cells + 1) / 2, 0);
+    for (int i = 0; i < cells; ++i) {
+        quint8 code = quint8(std::strchr(cellChars, maze[i]) - cellChars);
+        packedMaze[i >> 1] |= quint8(code << ((i & 1) * 4));
+    }
+    packed = true;
+
+    // Give the byte-per-cell grid back
+    std::vector<char>().swap(maze);
+}
+
+void MazeSimulation::unpackGrid()
+{
+    const int cells = ROWS * COLS;
+    maze.resize(cells);
+    for (int i = 0; i < cells; ++i) {
+        maze[i] = unpackCell(packedMaze.data(), i);
+    }
+    packed = false;
+    std::vector<quint8>().swap(packedMaze);
+}
+
+void MazeSimulation::setCell(int row, int col, char value)
+{
+    int i = row * COLS + col;
+    if (!packed) {
+        maze[i] = value;
+        return;
+    }
+    quint8 code = quint8(std::strchr(cellChars, value) - cellChars);
+    int shift = (i & 1) * 4;
+    packedMaze[i >> 1] = quint8((packedMaze[i >> 1] & ~(0xF << shift)) | (code << shift));
+}
+
+qint64 MazeSimulation::memoryBytes() const
+{
+    return qint64(maze.capacity()) * sizeof(char)
+         + qint64(packedMaze.capacity()) * sizeof(quint8)
+         + qint64(coinBits.capacity()) * sizeof(quint64)
+         + qint64(ghostList.capacity()) * sizeof(Ghost)
+         + qint64(ghostStartPositions.capacity()) * sizeof(QPoint);
+}
+
+int MazeSimulation::dx(Direction d) {
+    if (d == DirLeft) return -1;
+    if (d == DirRight) return 1;
+    return 0;
+}
+int MazeSimulation::dy(Direction d) {
+    if (d == DirUp) return -1;
+    if (d == DirDown) return 1;
+    return 0;
+}
+
+QPoint MazeSimulation::nextCell(const QPoint &pos, Direction dir) {
+    return QPoint(pos.x() + dx(dir), pos.y() + dy(dir));
+}
+
+bool MazeSimulation::isWall(int row, int col) const {
+    if (row < 0 || col < 0 || row >= ROWS || col >= COLS) {
+        return true;
+    }
+    return cell(row, col) == '1';
+}
+
+int MazeSimulation::step(Direction desiredDir)
+{
+    if (gameOver) {
+        return EventNone;
+    }
+
+    tickCount++;
+    gameTickCounter++;
+
+    int events = movePlayerTick(desiredDir);
+    if (events & EventLevelComplete) {
+        return events;
+    }
+    moveGhostsTick();
+
+    for (const Ghost &g : ghostList) {
+        if (g.pos == pos) {
+            lives--;
+            events |= EventLifeLost;
+            if (lives <= 0) {
+                gameOver = true;
+                totalScore = 0;
+                events |= EventGameOver;
+            } else {
+                pos = playerStartPos;
+                currentDir = DirNone;
+            }
+            break;
+        }
+    }
+    return events;
+}
+
+int MazeSimulation::movePlayerTick(Direction desiredDir)
+{
+    if (desiredDir != DirNone && desiredDir != currentDir) {
+        QPoint nxt = nextCell(pos, desiredDir);
+        if (!isWall(nxt.y(), nxt.x())) {
+            currentDir = desiredDir;
+        }
+    }
+
+    if (currentDir == DirNone) {
+        if (desiredDir != DirNone) {
+            QPoint nxt = nextCell(pos, desiredDir);
+            if (!isWall(nxt.y(), nxt.x())) {
+                currentDir = desiredDir;
+            }
+        }
+        return EventNone;
+    }
+
+    QPoint nxt = nextCell(pos, currentDir);
+    if (isWall(nxt.y(), nxt.x())) {
+        currentDir = DirNone;
+        return EventNone;
+    }
+
+    pos = nxt;
+    int events = EventMoved;
+
+    char here = cell(pos.y(), pos.x());
+    if (here == '2') {
+        setCell(pos.y(), pos.x(), '0');
+        int index = pos.y() * COLS + pos.x();
+        coinBits[index / 64] &= ~(quint64(1) << (index % 64));
+        coinCount--;
+        lastCoinPos = pos;
+        levelScore++;
+        totalScore++;
+        events |= EventCoin;
+    }
+    else if (here == 'E') {
+        loadLevel(currentLevel + 1);
+        events |= EventLevelComplete;
+    }
+    return events;
+}
+
+void MazeSimulation::moveGhostsTick()
+{
+    // Speed Control Check
+    if (gameTickCounter % ghostMoveFrequency != 0) {
+        return; // Skip ghost movement for this tick
+    }
+
+    std::uniform_int_distribution<> percent(0, 99);
+
+    for (Ghost &g : ghostList) {
+        Direction options[4];
+        int optionCount = 0;
+        Direction oppositeDir = DirNone;
+        if (g.dir == DirLeft) oppositeDir = DirRight;
+        else if (g.dir == DirRight) oppositeDir = DirLeft;
+        else if (g.dir == DirUp) oppositeDir = DirDown;
+        else if (g.dir == DirDown) oppositeDir = DirUp;
+
+        bool found = false;
+        for (Direction d : {DirLeft, DirRight, DirUp, DirDown}) {
+            QPoint nxt = nextCell(g.pos, d);
+            if (!isWall(nxt.y(), nxt.x()) && d != oppositeDir) {
+                options[optionCount++] = d;
+                found = found || d == g.dir;
+            }
+        }
+
+        if (optionCount == 0) {
+            QPoint nxt = nextCell(g.pos, oppositeDir);
+            if (oppositeDir != DirNone && !isWall(nxt.y(), nxt.x())) {
+                options[optionCount++] = oppositeDir;
+            }
+        }
+
+        if (optionCount > 0) {
+            if (found && percent(gen) < 80) {
+                // 80% chance to keep going straight
+            } else {
+                std::uniform_int_distribution<> pick(0, optionCount - 1);
+                g.dir = options[pick(gen)];
+            }
+
+            g.pos = nextCell(g.pos, g.dir);
+        }
+    }
+}
+
+void MazeSimulation::observe(Observation &obs) const
+{
+    obs.rows = ROWS;
+    obs.cols = COLS;
+    obs.grid = packed ? nullptr : maze.data();
+    obs.packedGrid = packed ? packedMaze.data() : nullptr;
+    obs.coinBits = coinBits.data();
+    obs.coinsLeft = coinCount;
+
+    obs.player = pos;
+    obs.playerDir = currentDir;
+    obs.lives = lives;
+
+    obs.ghostCount = std::min(int(ghostList.size()), Observation::MaxGhosts);
+    for (int i = 0; i < obs.ghostCount; ++i) {
+        obs.ghosts[i] = ghostList[i].pos;
+    }
+
+    // Local window centred on the player, walls outside the maze
+    const int half = Observation::Window / 2;
+    for (int r = 0; r < Observation::Window; ++r) {
+        int row = pos.y() - half + r;
+        for (int c = 0; c < Observation::Window; ++c) {
+            int col = pos.x() - half + c;
+            bool inside = row >= 0 && col >= 0 && row < ROWS && col < COLS;
+            obs.local[r * Observation::Window + c] = inside ? cell(row, col) : '1';
+        }
+    }
+    for (int i = 0; i < obs.ghostCount; ++i) {
+        int r = obs.ghosts[i].y() - pos.y() + half;
+        int c = obs.ghosts[i].x() - pos.x() + half;
+        if (r >= 0 && c >= 0 && r < Observation::Window && c < Observation::Window) {
+            obs.local[r * Observation::Window + c] = 'G';
+        }
+    }
+}
@@ -0,0 +1,144 @@
+#ifndef MAZESIMULATION_H
+#define MAZESIMULATION_H
+
+#include <QPoint>
+#include <vector>
+#include <random>
+
+enum Direction { DirNone = -1, DirLeft = 0, DirRight = 1, DirUp = 2, DirDown = 3 };
+
+struct Observation; // bot.h
+
+// Game rules and state for one maze session, with no graphics attached.
+// Every instance owns its RNG, so any number of them can be stepped
+// side by side (one session per thread at a time).
+class MazeSimulation
+{
+public:
+    // What happened during one step; GameScene uses this to sync sprites
+    enum Event {
+        EventNone = 0,
+        EventMoved = 1 << 0,
+        EventCoin = 1 << 1,
+        EventLevelComplete = 1 << 2,
+        EventLifeLost = 1 << 3,
+        EventGameOver = 1 << 4
+    };
+
+    struct Ghost {
+        QPoint pos;
+        Direction dir;
+    };
+
+    explicit MazeSimulation(quint64 seed = std::random_device{}());
+
+    void newGame();
+    void loadLevel(int levelNumber);
+
+    // Memory limits. A packed grid stores two cells per byte (applied now
+    // and to every later level). The budget caps how big levels may grow:
+    // it covers this simulation, generating the next level, and
+    // extraBytesPerCell for anything else sized by the maze (a tile layer,
+    // a bot's search buffers). 0 = no cap; the default is DefaultMemoryBudget.
+    static constexpr qint64 DefaultMemoryBudget = 64 * 1024 * 1024;
+    void setPackedGrid(bool on);
+    bool isPackedGrid() const { return packRequested; }
+    void setMemoryBudget(qint64 bytes, qint64 extraBytesPerCell = 0);
+    qint64 memoryBudget() const { return budget; }
+    // Largest maze in each direction, e.g. what a view shows at one pixel
+    // per cell. 0 = no limit; never below the level 1 size.
+    void setMaxSize(int rows, int cols) { maxRows = rows; maxCols = cols; }
+    qint64 memoryBytes() const;
+
+    // Advance one game tick. desiredDir is the turn the player is asking for.
+    int step(Direction desiredDir);
+
+    // Maze
+    int rows() const { return ROWS; }
+    int cols() const { return COLS; }
+    char cell(int row, int col) const { return cellAt(row * COLS + col); }
+    char cellAt(int index) const
+    {
+        return packed ? unpackCell(packedMaze.data(), index) : maze[index];
+    }
+    static char unpackCell(const quint8 *packedCells, int index)
+    {
+        return cellChars[(packedCells[index >> 1] >> ((index & 1) * 4)) & 0xF];
+    }
+    bool isWall(int row, int col) const;
+    static int dx(Direction d);
+    static int dy(Direction d);
+    static QPoint nextCell(const QPoint &pos, Direction dir);
+
+    // Entities
+    QPoint playerPos() const { return pos; }
+    QPoint playerStart() const { return playerStartPos; }
+    Direction playerDir() const { return currentDir; }
+    const std::vector<Ghost> &ghosts() const { return ghostList; }
+    QPoint lastCoin() const { return lastCoinPos; }
+
+    // Coins as a bitmap, one bit per cell in row-major order
+    const std::vector<quint64> &coinBitmap() const { return coinBits; }
+    int coinsLeft() const { return coinCount; }
+
+    // Fill a bot observation for the current tick. Never allocates.
+    void observe(Observation &obs) const;
+
+    // Progress
+    int level() const { return currentLevel; }
+    int levelSerial() const { return serial; } // Bumped on every loadLevel
+    int score() const { return levelScore; }
+    int total() const { return totalScore; }
+    int livesLeft() const { return lives; }
+    bool isGameOver() const { return gameOver; }
+    quint64 ticks() const { return tickCount; }
+
+private:
+    static constexpr char cellChars[] = "012EP"; // Packed nibble -> cell
+
+    std::mt19937 gen;
+
+    std::vector<char> maze; // Row-major, ROWS * COLS (empty when packed)
+    std::vector<quint8> packedMaze;
+    bool packed = false;
+    bool packRequested = false;
+    qint64 budget = 0;
+    qint64 maxCells = 0; // 0 = no cap
+    int maxRows = 0;
+    int maxCols = 0;
+    std::vector<quint64> coinBits;
+    int coinCount = 0;
+    int ROWS = 0;
+    int COLS = 0;
+
+    QPoint pos;
+    QPoint playerStartPos;
+    Direction currentDir = DirNone;
+    QPoint lastCoinPos;
+
+    std::vector<Ghost> ghostList;
+    std::vector<QPoint> ghostStartPositions;
+
+    int currentLevel = 1;
+    int serial = 0;
+    int levelScore = 0;
+    int totalScore = 0;
+    int lives = 3;
+    bool gameOver = false;
+    int gameTickCounter = 0;
+    int ghostMoveFrequency = 3;
+    quint64 tickCount = 0;
+
+    // Generation works on the unpacked grid only
+    char &at(int row, int col) { return maze[row * COLS + col]; }
+    void setCell(int row, int col, char value);
+    void packGrid();
+    void unpackGrid();
+
+    void generateMaze(int rows, int cols);
+    void populateMaze();
+    int movePlayerTick(Direction desiredDir);
+    void moveGhostsTick();
+};
+
+#endif // MAZESIMULATION_H
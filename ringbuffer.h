@@ -0,0 +1,50 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <array>
+
+// Fixed-capacity FIFO that never allocates.
+// When full, pushing drops the oldest entry so the newest input always wins.
+template <typename T, int Capacity>
+class RingBuffer
+{
+public:
+    void push(const T &value)
+    {
+        if (count == Capacity) {
+            head = (head + 1) % Capacity;
+            --count;
+            ++overflowCount;
+        }
+        items[(head + count) % Capacity] = value;
+        ++count;
+    }
+
+    bool pop(T &out)
+    {
+        if (count == 0) {
+            return false;
+        }
+        out = items[head];
+        head = (head + 1) % Capacity;
+        --count;
+        return true;
+    }
+
+    // Oldest entry; only valid when not empty
+    const T &front() const { return items[head]; }
+
+    void clear() { head = 0; count = 0; }
+    bool isEmpty() const { return count == 0; }
+    int size() const { return count; }
+    int overflows() const { return overflowCount; }
+    void resetOverflows() { overflowCount = 0; }
+
+private:
+    std::array<T, Capacity> items{};
+    int head = 0;
+    int count = 0;
+    int overflowCount = 0;
+};
+
+#endif // RINGBUFFER_H
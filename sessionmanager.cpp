@@ -0,0 +1,125 @@
+#include "sessionmanager.h"
+#include <QThread>
+#include <algorithm> // for std::min and std::max
+
+SessionManager::SessionManager(int sessionCount, quint64 seed, QObject *parent)
+    : QObject(parent)
+{
+    sessions.reserve(sessionCount);
+    for (int i = 0; i < sessionCount; ++i) {
+        // Spread seeds out so neighbouring sessions don't share RNG streams
+        quint64 sessionSeed = seed + quint64(i + 1) * 0x9E3779B97F4A7C15ULL;
+        sessions.push_back(std::make_unique<Session>(sessionSeed));
+        applyBudget(*sessions.back());
+        sessions.back()->sim.newGame();
+    }
+
+    pool.setMaxThreadCount(std::max(1, QThread::idealThreadCount()));
+
+    timer = new QTimer(this);
+    connect(timer, &QTimer::timeout, this, &SessionManager::stepAll);
+}
+
+SessionManager::~SessionManager()
+{
+    timer->stop();
+    pool.waitForDone();
+}
+
+void SessionManager::setBot(int index, std::unique_ptr<Bot> bot)
+{
+    sessions[index]->bot = std::move(bot);
+    applyBudget(*sessions[index]);
+}
+
+void SessionManager::setSessionBudget(qint64 bytes)
+{
+    sessionBudget = std::max<qint64>(0, bytes);
+    for (auto &s : sessions) {
+        applyBudget(*s);
+    }
+}
+
+void SessionManager::applyBudget(Session &s)
+{
+    // Takes effect from the next level
+    s.sim.setMemoryBudget(sessionBudget, s.bot ? s.bot->memoryBytesPerCell() : 0);
+}
+
+void SessionManager::setMaxLevelSize(int rows, int cols)
+{
+    for (auto &s : sessions) {
+        s->sim.setMaxSize(rows, cols); // Takes effect from the next level
+    }
+}
+
+void SessionManager::setWatched(int index)
+{
+    index = std::max(0, std::min(index, count() - 1));
+    if (index == watchedIndex) {
+        return;
+    }
+    watchedIndex = index;
+    emit watchedChanged(watchedSession());
+}
+
+void SessionManager::start(int tickMs)
+{
+    timer->start(tickMs);
+}
+
+void SessionManager::stop()
+{
+    timer->stop();
+}
+
+void SessionManager::stepAll()
+{
+    runTicks(1);
+}
+
+void SessionManager::runTicks(int ticks)
+{
+    if (sessions.empty() || ticks <= 0) {
+        return;
+    }
+    runSharded(ticks);
+    emit watchedStepped();
+}
+
+void SessionManager::runSharded(int ticks)
+{
+    int n = count();
+    int shards = std::min(pool.maxThreadCount(), n);
+    int perShard = (n + shards - 1) / shards;
+
+    for (int begin = 0; begin < n; begin += perShard) {
+        int end = std::min(n, begin + perShard);
+        pool.start([this, begin, end, ticks]() {
+            // Sessions are independent, so run each one's whole batch
+            // while its maze is still in cache
+            for (int i = begin; i < end; ++i) {
+                for (int t = 0; t < ticks; ++t) {
+                    stepSession(*sessions[i]);
+                }
+            }
+        });
+    }
+    pool.waitForDone();
+}
+
+void SessionManager::stepSession(Session &s)
+{
+    s.bestTotal = std::max(s.bestTotal, s.sim.total());
+    if (s.bot) {
+        s.sim.observe(s.obs);
+        s.input = s.bot->act(s.obs);
+    }
+    s.sim.step(s.input);
+
+    // Sessions loop forever: a finished game starts a new one
+    if (s.sim.isGameOver()) {
+        s.games++;
+        s.sim.newGame();
+    }
+}
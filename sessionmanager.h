@@ -0,0 +1,90 @@
+#ifndef SESSIONMANAGER_H
+#define SESSIONMANAGER_H
+
+#include <QObject>
+#include <QThreadPool>
+#include <QTimer>
+#include <memory>
+#include <vector>
+#include "mazesimulation.h"
+#include "bot.h"
+
+// Hosts many independent game sessions in one process.
+// Sessions are split into contiguous shards and stepped on a private
+// thread pool; each session has its own RNG and state, so shards never
+// touch shared data. Only the watched session is handed to a GameScene
+// for rendering (see watchedStepped()).
+class SessionManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SessionManager(int sessionCount, quint64 seed, QObject *parent = nullptr);
+    ~SessionManager();
+
+    int count() const { return int(sessions.size()); }
+    MazeSimulation *session(int index) { return &sessions[index]->sim; }
+
+    // Direction fed to a session on every tick until changed
+    void setInput(int index, Direction dir) { sessions[index]->input = dir; }
+    // Let a bot drive the session instead (takes ownership)
+    void setBot(int index, std::unique_ptr<Bot> bot);
+
+    // Memory budget per session in bytes (default DefaultSessionBudget),
+    // covering its simulation and its bot's buffers; 0 for none
+    static constexpr qint64 DefaultSessionBudget = 4 * 1024 * 1024;
+    void setSessionBudget(qint64 bytes);
+
+    // Cap every session's maze size, e.g. to the view they're shown in
+    void setMaxLevelSize(int rows, int cols);
+
+    // Pick the session to show; emits watchedChanged() when it changes
+    void setWatched(int index);
+    int watched() const { return watchedIndex; }
+    MazeSimulation *watchedSession() { return session(watchedIndex); }
+
+    // Real-time stepping on a timer (attract mode)
+    void start(int tickMs);
+    void stop();
+    bool isRunning() const { return timer->isActive(); }
+
+    // One tick for every session
+    void stepAll();
+    // Many ticks per session back to back, as fast as the pool allows
+    void runTicks(int ticks);
+
+    int gamesPlayed(int index) const { return sessions[index]->games; }
+    int bestTotal(int index) const { return sessions[index]->bestTotal; }
+
+signals:
+    // Emitted on the GUI thread once all shards are done, so the watched
+    // session can be read safely (connect to GameScene::syncFromSimulation)
+    void watchedStepped();
+    // A different session is now watched (connect to GameScene::watchSession)
+    void watchedChanged(MazeSimulation *session);
+
+private:
+    struct Session {
+        explicit Session(quint64 seed) : sim(seed) {}
+        MazeSimulation sim;
+        Direction input = DirNone;
+        std::unique_ptr<Bot> bot;
+        Observation obs;
+        int games = 0;
+        int bestTotal = 0;
+    };
+
+    // One allocation per session keeps neighbours on different cache lines
+    std::vector<std::unique_ptr<Session>> sessions;
+    QThreadPool pool;
+    QTimer *timer;
+    int watchedIndex = 0;
+    qint64 sessionBudget = DefaultSessionBudget;
+
+    void applyBudget(Session &s);
+
+    void runSharded(int ticks);
+    static void stepSession(Session &s);
+};
+
+#endif // SESSIONMANAGER_H
@@ -0,0 +1,52 @@
+#include "startuptimer.h"
+#include <QElapsedTimer>
+#include <QVector>
+#include <QPair>
+#include <QDebug>
+
+namespace
+{
+    QElapsedTimer clock;
+    QVector<QPair<const char *, qint64>> stages;
+    bool reported = false;
+}
+
+void StartupTimer::begin()
+{
+    clock.start();
+}
+
+void StartupTimer::mark(const char *stage)
+{
+    if (!clock.isValid() || reported) {
+        return;
+    }
+    for (const auto &s : stages) {
+        if (qstrcmp(s.first, stage) == 0) {
+            return; // Only the first time counts
+        }
+    }
+    stages.append({stage, clock.nsecsElapsed()});
+}
+
+void StartupTimer::report()
+{
+    if (!clock.isValid() || reported) {
+        return;
+    }
+    reported = true;
+
+    {
+        QDebug out = qInfo().nospace();
+        out << "Startup:";
+        for (const auto &s : stages) {
+            out << " " << s.first << " " << s.second / 1e6 << " ms;";
+        }
+    }
+
+    int budgetMs = qEnvironmentVariableIntValue("MAGE_STARTUP_BUDGET_MS");
+    if (budgetMs > 0 && !stages.isEmpty() && stages.last().second / 1000000 > budgetMs) {
+        qWarning().nospace() << "Startup over budget: " << stages.last().second / 1e6
+                             << " ms > " << budgetMs << " ms";
+    }
+}
@@ -0,0 +1,14 @@
+#ifndef STARTUPTIMER_H
+#define STARTUPTIMER_H
+
+// Cold-start timing, measured from the top of main().
+// Set MAGE_STARTUP_BUDGET_MS to get a warning when the first playable
+// frame comes later than that.
+namespace StartupTimer
+{
+    void begin();
+    void mark(const char *stage);
+    void report();
+}
+
+#endif // STARTUPTIMER_H
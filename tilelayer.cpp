@@ -0,0 +1,88 @@
+#include "tilelayer.h"
+#include <QPainter>
+#include <QDebug>
+#include <QStyleOptionGraphicsItem>
+#include <QtAlgorithms>
+#include <algorithm>
+#include <cstring>
+
+TileLayerItem::TileLayerItem(const MazeSimulation &sim, int cellSize, QColor wallColor, QColor coinColor,
+                             QGraphicsItem *parent)
+    : QGraphicsItem(parent), cellSize(cellSize), cols(sim.cols()), coinBits(sim.coinBitmap())
+{
+    const int rows = sim.rows();
+    const QRgb wallRgb = wallColor.rgb();
+    const QRgb coinRgb = coinColor.rgb();
+    floorRgb = qRgb(0, 0, 0); // Same as the scene background
+
+    image = QImage(cols * cellSize, rows * cellSize, QImage::Format_RGB32);
+
+    // Write the first scanline of each maze row, then copy it down the block
+    const int lineBytes = cols * cellSize * int(sizeof(QRgb));
+    for (int r = 0; r < rows; ++r) {
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(r * cellSize));
+        for (int c = 0; c < cols; ++c) {
+            char cell = sim.cell(r, c);
+            QRgb rgb = cell == '1' ? wallRgb : cell == '2' ? coinRgb : floorRgb;
+            for (int i = 0; i < cellSize; ++i) {
+                *line++ = rgb;
+            }
+        }
+        const uchar *first = image.constScanLine(r * cellSize);
+        for (int y = 1; y < cellSize; ++y) {
+            std::memcpy(image.scanLine(r * cellSize + y), first, lineBytes);
+        }
+    }
+
+    setFlag(ItemUsesExtendedStyleOption); // Fills in exposedRect
+    setAcceptedMouseButtons(Qt::NoButton);
+}
+
+void TileLayerItem::fillCell(int row, int col, QRgb rgb)
+{
+    for (int y = 0; y < cellSize; ++y) {
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(row * cellSize + y)) + col * cellSize;
+        for (int x = 0; x < cellSize; ++x) {
+            line[x] = rgb;
+        }
+    }
+}
+
+void TileLayerItem::clearCell(int row, int col)
+{
+    if (row < 0 || col < 0 || row >= image.height() / cellSize || col >= image.width() / cellSize) {
+        qWarning() << "TileLayerItem: cell" << row << col << "is outside the maze";
+        return;
+    }
+    fillCell(row, col, floorRgb);
+    update(col * cellSize, row * cellSize, cellSize, cellSize);
+}
+
+void TileLayerItem::syncCoins(const std::vector<quint64> &bits)
+{
+    const size_t words = std::min(bits.size(), coinBits.size());
+    for (size_t w = 0; w < words; ++w) {
+        // Coins never come back within a level, so only look for ones that went
+        quint64 gone = coinBits[w] & ~bits[w];
+        coinBits[w] &= bits[w];
+        while (gone) {
+            int index = int(w * 64) + qCountTrailingZeroBits(gone);
+            clearCell(index / cols, index % cols);
+            gone &= gone - 1;
+        }
+    }
+}
+
+QRectF TileLayerItem::boundingRect() const
+{
+    return QRectF(0, 0, image.width(), image.height());
+}
+
+void TileLayerItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    Q_UNUSED(widget);
+
+    // Only blit the part that's actually being repainted
+    QRect area = option->exposedRect.toAlignedRect() & image.rect();
+    painter->drawImage(area.topLeft(), image, area);
+}
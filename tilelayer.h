@@ -0,0 +1,43 @@
+#ifndef TILELAYER_H
+#define TILELAYER_H
+
+#include <QGraphicsItem>
+#include <QImage>
+#include <QColor>
+#include <vector>
+#include "mazesimulation.h"
+
+// Whole maze baked into one QImage, a flat colour block per cell.
+// Used instead of per-tile pixmap items once cells get too small for the
+// sprites to read; painting is a single unscaled blit. The image costs
+// 4 bytes per pixel and is no bigger than the view, since levels are
+// capped at one cell per pixel.
+class TileLayerItem : public QGraphicsItem
+{
+public:
+    TileLayerItem(const MazeSimulation &sim, int cellSize, QColor wallColor, QColor coinColor,
+                  QGraphicsItem *parent = nullptr);
+
+    // Paint a collected coin's cell back to floor
+    void clearCell(int row, int col);
+
+    // Clear every coin that is gone from the simulation's coin bitmap,
+    // however many were collected since the last call
+    void syncCoins(const std::vector<quint64> &bits);
+
+    qint64 memoryBytes() const { return image.sizeInBytes() + qint64(coinBits.size()) * 8; }
+
+    QRectF boundingRect() const override;
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = nullptr) override;
+
+private:
+    QImage image;
+    int cellSize;
+    int cols;
+    QRgb floorRgb;
+    std::vector<quint64> coinBits; // Coins still drawn, same layout as the simulation's
+
+    void fillCell(int row, int col, QRgb rgb);
+};
+
+#endif // TILELAYER_H